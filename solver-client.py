@@ -0,0 +1,83 @@
+#!/usr/bin/env python3
+"""Sends solve requests to a running solver-server and prints its JSON-lines responses."""
+
+import argparse
+import json
+import socket
+import sys
+import threading
+import time
+
+
+def read_weights(path):
+    with open(path) as file:
+        return [int(weight) for weight in file.read().split()]
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("--socket", default="/tmp/mhe.sock", help="Unix domain socket of the server")
+    parser.add_argument("--data", default="./data.txt", help="Text instance to solve")
+    parser.add_argument("--capacity", type=int, default=0, help="Bin weight limit")
+    parser.add_argument("--algorithm", default="tabu-search", help="Name of a solver binary")
+    parser.add_argument("--args", type=int, nargs="*", default=[], help="Positional args of the solver")
+    parser.add_argument("--option", action="append", default=[], metavar="NAME=VALUE", help="Solver option")
+    parser.add_argument("--time-limit-ms", type=int, default=0, help="Budget counted from receipt")
+    parser.add_argument("--count", type=int, default=1, help="Requests to send at once")
+    parser.add_argument("--cancel-after-ms", type=int, default=0, help="Cancel every request after this delay")
+    parser.add_argument("--metrics", action="store_true", help="Print the queue metrics once all are sent")
+    parser.add_argument("--summary", action="store_true", help="Print responses without their bins")
+    options = parser.parse_args()
+
+    items = read_weights(options.data)
+    solver_options = dict(option.split("=", 1) for option in options.option)
+
+    connection = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+    connection.connect(options.socket)
+    lines = connection.makefile("r")
+
+    def send(request):
+        connection.sendall((json.dumps(request) + "\n").encode())
+
+    ids = [f"request-{i}" for i in range(options.count)]
+    for request_id in ids:
+        send({
+            "id": request_id,
+            "algorithm": options.algorithm,
+            "items": items,
+            "capacity": options.capacity,
+            "args": options.args,
+            "options": solver_options,
+            "time_limit_ms": options.time_limit_ms,
+        })
+
+    if options.metrics:
+        send({"metrics": True})
+
+    if options.cancel_after_ms > 0:
+        def cancel():
+            time.sleep(options.cancel_after_ms / 1000)
+            for request_id in ids:
+                send({"cancel": request_id})
+
+        threading.Thread(target=cancel, daemon=True).start()
+
+    pending = len(ids) + (1 if options.metrics else 0)
+    while pending:
+        line = lines.readline()
+        if not line:
+            sys.exit("Server closed the connection")
+
+        response = json.loads(line)
+        # Cancelling a request that has already finished is answered with an error of its own.
+        if response.get("status") == "error" and "No queued or running" in response.get("error", ""):
+            continue
+
+        if options.summary:
+            response.pop("bins", None)
+        print(json.dumps(response))
+        pending -= 1
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,31 @@
+#include "Barrier.h"
+#include <functional>
+#include <mutex>
+
+Barrier::Barrier(int thread_count, std::function<void()> completion_cb)
+    : completion_cb(std::move(completion_cb)),
+      thread_count(thread_count),
+      waiting_count(0),
+      generation(0) {
+}
+
+auto Barrier::arrive_and_wait() -> void {
+    auto lock = std::unique_lock<std::mutex>{this->mutex};
+    auto arrival_generation = this->generation;
+
+    if (++this->waiting_count < this->thread_count) {
+        this->all_arrived.wait(lock, [this, arrival_generation]() {
+            return this->generation != arrival_generation;
+        });
+
+        return;
+    }
+
+    if (this->completion_cb) {
+        this->completion_cb();
+    }
+
+    this->waiting_count = 0;
+    this->generation++;
+    this->all_arrived.notify_all();
+}
@@ -0,0 +1,26 @@
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+
+#ifndef BARRIER_H
+#define BARRIER_H
+
+// Reusable barrier for a fixed number of threads. The last thread to arrive runs
+// the completion callback before any of them continues, so the callback sees
+// every thread's work and may change shared state without further locking.
+class Barrier {
+private:
+    std::mutex mutex;
+    std::condition_variable all_arrived;
+    std::function<void()> completion_cb;
+    int thread_count;
+    int waiting_count;
+    int generation;
+
+public:
+    Barrier(int thread_count, std::function<void()> completion_cb);
+
+    auto arrive_and_wait() -> void;
+};
+
+#endif // BARRIER_H
@@ -0,0 +1,238 @@
+#include "Batch.h"
+#include "Instance.h"
+#include "Json.h"
+#include "Solver.h"
+#include "ThreadPool.h"
+#include "utils.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+const auto BATCH_FIELD_NAMES = std::vector<std::string>{
+    "instance",
+    "items",
+    "capacity",
+    "lower_bound",
+    "best_bins",
+    "gap",
+    "elapsed_ms",
+    "time_to_best_ms",
+    "error",
+};
+
+// Value of every BATCH_FIELD_NAMES entry; empty ones are left out of JSON lines.
+using BatchFields = std::vector<std::string>;
+
+static auto is_string_field(int field_index) -> bool {
+    return field_index == 0 || field_index == (int)BATCH_FIELD_NAMES.size() - 1;
+}
+
+static auto ends_with(const std::string &str, const std::string &suffix) -> bool {
+    return str.size() >= suffix.size() &&
+           str.compare(str.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+static auto quote_csv(const std::string &str) -> std::string {
+    if (str.find_first_of(",\"\n") == std::string::npos) {
+        return str;
+    }
+
+    auto quoted = std::string{"\""};
+
+    for (auto c : str) {
+        quoted += c == '"' ? std::string{"\"\""} : std::string{c == '\n' ? ' ' : c};
+    }
+
+    return quoted + "\"";
+}
+
+// Writes whole rows under a lock and flushes each, so readers see every job as it finishes.
+class BatchSink {
+private:
+    std::ofstream file;
+    std::ostream *out;
+    bool json_lines;
+    std::mutex mutex;
+
+public:
+    explicit BatchSink(const std::string &path)
+        : out(&std::cout),
+          json_lines(ends_with(path, ".jsonl")) {
+        if (path.empty()) {
+            return;
+        }
+
+        this->file.open(path);
+        if (!this->file) {
+            throw std::runtime_error{"Cannot create batch output file: " + path};
+        }
+
+        this->out = &this->file;
+    }
+
+    auto write_header() -> void {
+        if (this->json_lines) {
+            return;
+        }
+
+        for (auto i : range(BATCH_FIELD_NAMES.size())) {
+            *this->out << (i ? "," : "") << BATCH_FIELD_NAMES[i];
+        }
+
+        *this->out << std::endl;
+    }
+
+    auto write(const BatchFields &fields) -> void {
+        auto row = std::ostringstream{};
+
+        if (this->json_lines) {
+            row << "{";
+
+            for (auto i : range(fields.size())) {
+                if (fields[i].empty()) {
+                    continue;
+                }
+
+                row << (i ? ", " : "") << quote_json(BATCH_FIELD_NAMES[i]) << ": "
+                    << (is_string_field(i) ? quote_json(fields[i]) : fields[i]);
+            }
+
+            row << "}";
+        } else {
+            for (auto i : range(fields.size())) {
+                row << (i ? "," : "") << quote_csv(fields[i]);
+            }
+        }
+
+        auto lock = std::lock_guard<std::mutex>{this->mutex};
+        *this->out << row.str() << std::endl;
+    }
+};
+
+auto collect_batch_jobs(const std::string &source, int bin_weight_limit) -> std::vector<BatchJob> {
+    auto jobs = std::vector<BatchJob>{};
+    // Missing files are kept with size 0, so they fail as jobs of their own.
+    auto add_job = [&](const std::filesystem::path &path, int job_bin_weight_limit) {
+        auto error = std::error_code{};
+        auto size = std::filesystem::file_size(path, error);
+
+        jobs.push_back(BatchJob{path.string(), job_bin_weight_limit, error ? 0 : size});
+    };
+
+    if (std::filesystem::is_directory(source)) {
+        for (auto &entry : std::filesystem::directory_iterator{source}) {
+            if (entry.is_regular_file()) {
+                add_job(entry.path(), bin_weight_limit);
+            }
+        }
+    } else {
+        auto manifest = std::ifstream{source};
+        if (!manifest) {
+            throw std::runtime_error{"Cannot open batch manifest: " + source};
+        }
+
+        auto directory = std::filesystem::path{source}.parent_path();
+        auto line = std::string{};
+
+        while (std::getline(manifest, line)) {
+            line = line.substr(0, line.find('#'));
+
+            auto fields = std::istringstream{line};
+            auto path = std::string{};
+            auto job_bin_weight_limit = bin_weight_limit;
+
+            if (!(fields >> path)) {
+                continue;
+            }
+
+            fields >> job_bin_weight_limit;
+            add_job(directory / path, job_bin_weight_limit);
+        }
+    }
+
+    // Paths break ties, so the order does not depend on the directory listing.
+    std::sort(jobs.begin(), jobs.end(), [](auto &a, auto &b) {
+        return a.size != b.size ? a.size > b.size : a.path < b.path;
+    });
+
+    return jobs;
+}
+
+static auto solve_batch_job(
+    const BatchJob &job,
+    const std::string &algorithm,
+    const SolveParams &params,
+    const SolveBudget &budget,
+    SolveWorkspace &workspace)
+    -> BatchFields {
+    auto fields = BatchFields(BATCH_FIELD_NAMES.size());
+    fields[0] = job.path;
+
+    try {
+        auto instance = load_instance(job.path, job.bin_weight_limit, workspace.get_weight_buffer());
+        fields[1] = std::to_string(instance->get_item_count());
+        fields[2] = std::to_string(instance->get_bin_weight_limit());
+
+        auto job_budget = budget;
+        job_budget.workspace = &workspace;
+
+        auto result = solve(instance, algorithm, params, job_budget);
+        auto &statistics = result.statistics;
+
+        fields[3] = std::to_string(statistics.get_lower_bound());
+        fields[4] = std::to_string(statistics.get_best_filled_bin_count());
+        fields[5] = std::to_string(statistics.get_best_filled_bin_count() - statistics.get_lower_bound());
+        fields[6] = std::to_string(statistics.get_elapsed_ms());
+        fields[7] = std::to_string(statistics.get_time_to_best_ms());
+    } catch (const std::exception &error) {
+        fields.back() = error.what();
+    }
+
+    return fields;
+}
+
+auto run_batch(
+    const std::vector<BatchJob> &jobs,
+    const std::string &algorithm,
+    const SolveParams &params,
+    const SolveBudget &budget,
+    int job_count,
+    const std::string &output_path)
+    -> int {
+    auto sink = BatchSink{output_path};
+    sink.write_header();
+
+    auto thread_pool = ThreadPool{std::min(resolve_thread_count(job_count), std::max(1, (int)jobs.size()))};
+    auto next_job_index = std::atomic<int>{0};
+    auto failed_job_count = std::atomic<int>{0};
+
+    // Workers take the next largest job as soon as they are free. Each keeps one
+    // workspace for the whole batch, so the pools of the solvers and the weight
+    // buffers of the instances are reused by every job it takes.
+    thread_pool.run_chunks(thread_pool.get_thread_count(), [&](int) {
+        auto workspace = SolveWorkspace{};
+
+        for (auto i = next_job_index.fetch_add(1); i < (int)jobs.size(); i = next_job_index.fetch_add(1)) {
+            auto fields = solve_batch_job(jobs[i], algorithm, params, budget, workspace);
+
+            if (!fields.back().empty()) {
+                failed_job_count.fetch_add(1);
+            }
+
+            sink.write(fields);
+        }
+    });
+
+    return failed_job_count.load();
+}
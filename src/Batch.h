@@ -0,0 +1,35 @@
+#include "Solver.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#ifndef BATCH_H
+#define BATCH_H
+
+struct BatchJob {
+    std::string path;
+    // Not greater than 0 means the default of load_instance.
+    int bin_weight_limit;
+    // File size, the proxy of instance size used for ordering.
+    std::uintmax_t size;
+};
+
+// Every regular file of a directory, or every `path [capacity]` line of a
+// manifest (paths relative to it, # starts a comment), largest file first so
+// the longest jobs do not start last.
+auto collect_batch_jobs(const std::string &source, int bin_weight_limit) -> std::vector<BatchJob>;
+
+// Solves the jobs on `job_count` threads (not greater than 0 means one per
+// hardware thread) and writes one result per job as soon as it finishes: JSON
+// lines when `output_path` ends with .jsonl, otherwise CSV, to stdout when it is
+// empty. Failed jobs get an error instead of a result. Returns the failed job count.
+auto run_batch(
+    const std::vector<BatchJob> &jobs,
+    const std::string &algorithm,
+    const SolveParams &params,
+    const SolveBudget &budget,
+    int job_count,
+    const std::string &output_path)
+    -> int;
+
+#endif // BATCH_H
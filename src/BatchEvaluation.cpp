@@ -0,0 +1,258 @@
+#include "BatchEvaluation.h"
+#include "Genome.h"
+#include "Instance.h"
+#include "Profile.h"
+#include "Solution.h"
+#include "Statistics.h"
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define BATCH_EVALUATION_X86
+#include <immintrin.h>
+#endif
+
+// Inputs shared by every kernel. Groups smaller than the lane count repeat
+// their first genome in the spare lanes and drop those results.
+template <typename Index>
+struct BatchInput {
+    const int *weights;
+    int bin_weight_limit;
+    int item_count;
+    const Index *const *genome_items;
+    int genome_count;
+    int *filled_bin_counts;
+};
+
+template <typename Index>
+static auto count_filled_bins_scalar(const BatchInput<Index> &input) -> void {
+    for (auto i = 0; i < input.genome_count; i++) {
+        input.filled_bin_counts[i] = count_filled_bins(
+            input.weights,
+            input.genome_items[i],
+            input.item_count,
+            input.bin_weight_limit);
+    }
+}
+
+#ifdef BATCH_EVALUATION_X86
+
+const auto SSE2_LANE_COUNT = 4;
+const auto AVX2_LANE_COUNT = 8;
+
+template <typename Index>
+static auto count_filled_bins_sse2(const BatchInput<Index> &input) -> void {
+    auto limit = _mm_set1_epi32(input.bin_weight_limit);
+
+    for (auto first = 0; first < input.genome_count; first += SSE2_LANE_COUNT) {
+        const Index *lanes[SSE2_LANE_COUNT];
+        for (auto lane = 0; lane < SSE2_LANE_COUNT; lane++) {
+            lanes[lane] = input.genome_items[first + lane < input.genome_count ? first + lane : first];
+        }
+
+        auto loads = _mm_setzero_si128();
+        auto bin_counts = _mm_set1_epi32(1);
+
+        for (auto i = 0; i < input.item_count; i++) {
+            auto bag_weights = _mm_set_epi32(
+                input.weights[lanes[3][i]],
+                input.weights[lanes[2][i]],
+                input.weights[lanes[1][i]],
+                input.weights[lanes[0][i]]);
+            auto sums = _mm_add_epi32(loads, bag_weights);
+            auto overflows = _mm_cmpgt_epi32(sums, limit);
+
+            bin_counts = _mm_sub_epi32(bin_counts, overflows);
+            loads = _mm_or_si128(
+                _mm_and_si128(overflows, bag_weights),
+                _mm_andnot_si128(overflows, sums));
+        }
+
+        alignas(16) int lane_bin_counts[SSE2_LANE_COUNT];
+        _mm_store_si128((__m128i *)lane_bin_counts, bin_counts);
+
+        for (auto lane = 0; lane < SSE2_LANE_COUNT && first + lane < input.genome_count; lane++) {
+            input.filled_bin_counts[first + lane] = lane_bin_counts[lane];
+        }
+    }
+}
+
+// Loads items [i, i + 8) of a genome as 32-bit indexes.
+__attribute__((target("avx2"))) static inline auto load_avx2_items(const std::uint16_t *items) -> __m256i {
+    return _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *)items));
+}
+
+__attribute__((target("avx2"))) static inline auto load_avx2_items(const std::uint32_t *items) -> __m256i {
+    return _mm256_loadu_si256((const __m256i *)items);
+}
+
+// Transposes 8 rows of 8 indexes in place, so rows[i] holds item i of every lane.
+__attribute__((target("avx2"))) static inline auto transpose_avx2_rows(__m256i *rows) -> void {
+    __m256i pairs[8];
+    for (auto i = 0; i < 8; i += 2) {
+        pairs[i] = _mm256_unpacklo_epi32(rows[i], rows[i + 1]);
+        pairs[i + 1] = _mm256_unpackhi_epi32(rows[i], rows[i + 1]);
+    }
+
+    __m256i quads[8];
+    for (auto i = 0; i < 8; i += 4) {
+        quads[i] = _mm256_unpacklo_epi64(pairs[i], pairs[i + 2]);
+        quads[i + 1] = _mm256_unpackhi_epi64(pairs[i], pairs[i + 2]);
+        quads[i + 2] = _mm256_unpacklo_epi64(pairs[i + 1], pairs[i + 3]);
+        quads[i + 3] = _mm256_unpackhi_epi64(pairs[i + 1], pairs[i + 3]);
+    }
+
+    for (auto i = 0; i < 4; i++) {
+        rows[i] = _mm256_permute2x128_si256(quads[i], quads[i + 4], 0x20);
+        rows[i + 4] = _mm256_permute2x128_si256(quads[i], quads[i + 4], 0x31);
+    }
+}
+
+// Adds one bag per lane to the lanes' last bins, opening a new bin where it overflows.
+__attribute__((target("avx2"))) static inline auto add_avx2_bags(
+    const int *weights,
+    __m256i items,
+    __m256i limit,
+    __m256i &loads,
+    __m256i &bin_counts)
+    -> void {
+    auto bag_weights = _mm256_i32gather_epi32(weights, items, 4);
+    auto sums = _mm256_add_epi32(loads, bag_weights);
+    auto overflows = _mm256_cmpgt_epi32(sums, limit);
+
+    bin_counts = _mm256_sub_epi32(bin_counts, overflows);
+    loads = _mm256_blendv_epi8(sums, bag_weights, overflows);
+}
+
+template <typename Index>
+__attribute__((target("avx2"))) static auto count_filled_bins_avx2(const BatchInput<Index> &input) -> void {
+    auto limit = _mm256_set1_epi32(input.bin_weight_limit);
+    auto block_item_count = input.item_count / AVX2_LANE_COUNT * AVX2_LANE_COUNT;
+
+    for (auto first = 0; first < input.genome_count; first += AVX2_LANE_COUNT) {
+        const Index *lanes[AVX2_LANE_COUNT];
+        for (auto lane = 0; lane < AVX2_LANE_COUNT; lane++) {
+            lanes[lane] = input.genome_items[first + lane < input.genome_count ? first + lane : first];
+        }
+
+        auto loads = _mm256_setzero_si256();
+        auto bin_counts = _mm256_set1_epi32(1);
+
+        for (auto i = 0; i < block_item_count; i += AVX2_LANE_COUNT) {
+            __m256i rows[AVX2_LANE_COUNT];
+            for (auto lane = 0; lane < AVX2_LANE_COUNT; lane++) {
+                rows[lane] = load_avx2_items(lanes[lane] + i);
+            }
+
+            transpose_avx2_rows(rows);
+
+            for (auto j = 0; j < AVX2_LANE_COUNT; j++) {
+                add_avx2_bags(input.weights, rows[j], limit, loads, bin_counts);
+            }
+        }
+
+        for (auto i = block_item_count; i < input.item_count; i++) {
+            auto items = _mm256_set_epi32(
+                lanes[7][i], lanes[6][i], lanes[5][i], lanes[4][i],
+                lanes[3][i], lanes[2][i], lanes[1][i], lanes[0][i]);
+
+            add_avx2_bags(input.weights, items, limit, loads, bin_counts);
+        }
+
+        alignas(32) int lane_bin_counts[AVX2_LANE_COUNT];
+        _mm256_store_si256((__m256i *)lane_bin_counts, bin_counts);
+
+        for (auto lane = 0; lane < AVX2_LANE_COUNT && first + lane < input.genome_count; lane++) {
+            input.filled_bin_counts[first + lane] = lane_bin_counts[lane];
+        }
+    }
+}
+
+#endif
+
+auto get_best_batch_kernel() -> BatchKernel {
+#ifdef BATCH_EVALUATION_X86
+    static const auto best_kernel = __builtin_cpu_supports("avx2") ? BatchKernel::AVX2 : BatchKernel::SSE2;
+    return best_kernel;
+#else
+    return BatchKernel::SCALAR;
+#endif
+}
+
+auto get_batch_kernel_name(BatchKernel kernel) -> std::string {
+    switch (kernel) {
+    case BatchKernel::AVX2:
+        return "avx2";
+    case BatchKernel::SSE2:
+        return "sse2";
+    default:
+        return "scalar";
+    }
+}
+
+template <typename Index>
+static auto count_filled_bins_batch(const BatchInput<Index> &input, BatchKernel kernel) -> void {
+#ifdef BATCH_EVALUATION_X86
+    if (kernel == BatchKernel::AVX2) {
+        count_filled_bins_avx2(input);
+        return;
+    }
+
+    if (kernel == BatchKernel::SSE2) {
+        count_filled_bins_sse2(input);
+        return;
+    }
+#endif
+
+    count_filled_bins_scalar(input);
+}
+
+template <typename Index>
+static auto count_filled_bins_batch_of(
+    const Instance &instance,
+    const Genome *const *genomes,
+    int genome_count,
+    int *filled_bin_counts,
+    BatchKernel kernel)
+    -> void {
+    // Kept by the calling thread, so batches do not allocate once it has grown.
+    thread_local auto genome_items = std::vector<const Index *>{};
+
+    genome_items.resize(genome_count);
+    for (auto i = 0; i < genome_count; i++) {
+        genome_items[i] = genomes[i]->template get_packed_items<Index>();
+    }
+
+    count_filled_bins_batch(
+        BatchInput<Index>{
+            instance.get_weights(),
+            instance.get_bin_weight_limit(),
+            instance.get_item_count(),
+            genome_items.data(),
+            genome_count,
+            filled_bin_counts},
+        kernel);
+}
+
+auto count_filled_bins_batch(
+    const Instance &instance,
+    const Genome *const *genomes,
+    int genome_count,
+    int *filled_bin_counts,
+    BatchKernel kernel)
+    -> void {
+    if (!genome_count) {
+        return;
+    }
+
+    count_evaluation(genome_count);
+    profile_count(ProfileCounter::FULL_DECODES, genome_count);
+
+    if (genomes[0]->get_packed_items<std::uint16_t>()) {
+        count_filled_bins_batch_of<std::uint16_t>(instance, genomes, genome_count, filled_bin_counts, kernel);
+    } else {
+        count_filled_bins_batch_of<std::uint32_t>(instance, genomes, genome_count, filled_bin_counts, kernel);
+    }
+}
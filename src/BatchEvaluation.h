@@ -0,0 +1,33 @@
+#include "Genome.h"
+#include "Instance.h"
+#include <string>
+
+#ifndef BATCH_EVALUATION_H
+#define BATCH_EVALUATION_H
+
+// Next-fit decoding is sequential within a genome, so batch kernels decode one
+// genome per SIMD lane instead.
+enum class BatchKernel {
+    SCALAR,
+    // 4 lanes; part of every x86-64 CPU.
+    SSE2,
+    // 8 lanes with gathered weights; picked at runtime when the CPU supports it.
+    AVX2,
+};
+
+// Fastest kernel the running CPU supports.
+auto get_best_batch_kernel() -> BatchKernel;
+
+auto get_batch_kernel_name(BatchKernel kernel) -> std::string;
+
+// Writes the filled bin count of every genome to `filled_bin_counts`. All
+// genomes must be permutations of the items of `instance`.
+auto count_filled_bins_batch(
+    const Instance &instance,
+    const Genome *const *genomes,
+    int genome_count,
+    int *filled_bin_counts,
+    BatchKernel kernel = get_best_batch_kernel())
+    -> void;
+
+#endif // BATCH_EVALUATION_H
@@ -0,0 +1,140 @@
+#include "Constructive.h"
+#include "Genome.h"
+#include "Instance.h"
+#include "utils.h"
+#include <algorithm>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+static auto sort_items_by_decreasing_weight(const Instance &instance) -> std::vector<int> {
+    auto weights = instance.get_weights();
+    auto items = range(instance.get_item_count());
+
+    std::stable_sort(items.begin(), items.end(), [weights](int a, int b) {
+        return weights[a] > weights[b];
+    });
+
+    return items;
+}
+
+// Concatenates the bins in creation order, keeping the placement order within
+// every bin, so each one starts with the bag that opened it.
+static auto compose_genome(
+    const std::vector<int> &placement_order,
+    const std::vector<int> &item_bins,
+    int bin_count)
+    -> Genome {
+    auto bin_ends = std::vector<int>(bin_count + 1);
+    for (auto bin : item_bins) {
+        bin_ends[bin + 1]++;
+    }
+
+    for (auto i = 0; i < bin_count; i++) {
+        bin_ends[i + 1] += bin_ends[i];
+    }
+
+    auto items = std::vector<int>(item_bins.size());
+    for (auto item : placement_order) {
+        items[bin_ends[item_bins[item]]++] = item;
+    }
+
+    return Genome{items};
+}
+
+auto build_first_fit_decreasing_genome(const Instance &instance) -> Genome {
+    auto weights = instance.get_weights();
+    auto item_count = instance.get_item_count();
+    auto limit = instance.get_bin_weight_limit();
+
+    // Max segment tree over the residuals of item_count potential bins; unopened bins
+    // have a full residual, so the leftmost fitting bin is a new one when no open bin fits.
+    auto leaf_count = 1;
+    while (leaf_count < item_count) {
+        leaf_count *= 2;
+    }
+
+    auto residuals = std::vector<int>(2 * leaf_count, limit);
+    for (auto i = item_count; i < leaf_count; i++) {
+        residuals[leaf_count + i] = -1;
+    }
+
+    for (auto node = leaf_count - 1; node > 0; node--) {
+        residuals[node] = std::max(residuals[2 * node], residuals[2 * node + 1]);
+    }
+
+    auto placement_order = sort_items_by_decreasing_weight(instance);
+    auto item_bins = std::vector<int>(item_count);
+    auto bin_count = 0;
+
+    for (auto item : placement_order) {
+        auto weight = std::min(weights[item], limit);
+
+        auto node = 1;
+        while (node < leaf_count) {
+            node = residuals[2 * node] >= weight ? 2 * node : 2 * node + 1;
+        }
+
+        auto bin = node - leaf_count;
+        item_bins[item] = bin;
+        bin_count = std::max(bin_count, bin + 1);
+
+        residuals[node] -= weight;
+        for (node /= 2; node > 0; node /= 2) {
+            residuals[node] = std::max(residuals[2 * node], residuals[2 * node + 1]);
+        }
+    }
+
+    return compose_genome(placement_order, item_bins, bin_count);
+}
+
+auto build_best_fit_decreasing_genome(const Instance &instance) -> Genome {
+    auto weights = instance.get_weights();
+    auto item_count = instance.get_item_count();
+    auto limit = instance.get_bin_weight_limit();
+
+    // (residual, bin) of every open bin.
+    auto residuals = std::multiset<std::pair<int, int>>{};
+
+    auto placement_order = sort_items_by_decreasing_weight(instance);
+    auto item_bins = std::vector<int>(item_count);
+    auto bin_count = 0;
+
+    for (auto item : placement_order) {
+        auto weight = std::min(weights[item], limit);
+        auto tightest_bin = residuals.lower_bound({weight, -1});
+
+        auto bin = bin_count;
+        auto residual = limit;
+
+        if (tightest_bin != residuals.end()) {
+            std::tie(residual, bin) = *tightest_bin;
+            residuals.erase(tightest_bin);
+        } else {
+            bin_count++;
+        }
+
+        item_bins[item] = bin;
+        residuals.insert({residual - weight, bin});
+    }
+
+    return compose_genome(placement_order, item_bins, bin_count);
+}
+
+auto build_start_genome(const std::string &start, const Instance &instance) -> Genome {
+    if (start == "instance") {
+        return Genome{instance.get_item_count()};
+    }
+
+    if (start == "ffd") {
+        return build_first_fit_decreasing_genome(instance);
+    }
+
+    if (start == "bfd") {
+        return build_best_fit_decreasing_genome(instance);
+    }
+
+    throw std::invalid_argument{"Unknown start: " + start};
+}
@@ -0,0 +1,23 @@
+#include "Genome.h"
+#include "Instance.h"
+#include <string>
+#include <vector>
+
+#ifndef CONSTRUCTIVE_H
+#define CONSTRUCTIVE_H
+
+// Constructive heuristics placing bags heaviest first. Their packings are returned
+// as genomes listing every bin's bags in bin creation order, each bin starting with
+// the bag that opened it; that bag did not fit any earlier bin, so next-fit decoding
+// reproduces the packing exactly.
+
+// First fit: the leftmost bin with room, found in a max segment tree of bin residuals.
+auto build_first_fit_decreasing_genome(const Instance &instance) -> Genome;
+
+// Best fit: the bin with the least room that still fits, found in a multiset of residuals.
+auto build_best_fit_decreasing_genome(const Instance &instance) -> Genome;
+
+// Start selected by the --start option: instance order, ffd or bfd.
+auto build_start_genome(const std::string &start, const Instance &instance) -> Genome;
+
+#endif // CONSTRUCTIVE_H
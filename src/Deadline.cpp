@@ -0,0 +1,22 @@
+#include "Deadline.h"
+#include <atomic>
+#include <chrono>
+
+Deadline::Deadline(int time_limit_ms, const std::atomic<bool> *cancelled)
+    : end(time_limit_ms > 0
+              ? std::chrono::steady_clock::now() + std::chrono::milliseconds{time_limit_ms}
+              : std::chrono::steady_clock::time_point::max()),
+      cancelled(cancelled),
+      limited(time_limit_ms > 0 || cancelled),
+      expired(false),
+      countdown(DEADLINE_CHECK_INTERVAL) {
+}
+
+auto Deadline::is_expired_now() -> bool {
+    if (this->limited && !this->expired) {
+        this->expired = (this->cancelled && this->cancelled->load(std::memory_order_relaxed)) ||
+                        std::chrono::steady_clock::now() >= this->end;
+    }
+
+    return this->expired;
+}
@@ -0,0 +1,43 @@
+#include <atomic>
+#include <chrono>
+
+#ifndef DEADLINE_H
+#define DEADLINE_H
+
+// Calls of is_expired() between two clock reads.
+const auto DEADLINE_CHECK_INTERVAL = 256;
+
+// Wall-clock budget of a run, optionally cut short by a cancellation flag set
+// from another thread. Not thread-safe: every thread checks its own copy.
+class Deadline {
+private:
+    std::chrono::steady_clock::time_point end;
+    const std::atomic<bool> *cancelled;
+    bool limited;
+    bool expired;
+    int countdown;
+
+public:
+    // Time limit not greater than 0 means no limit. The flag, if any, must outlive every copy.
+    explicit Deadline(int time_limit_ms = 0, const std::atomic<bool> *cancelled = nullptr);
+
+    // Reads the clock only every DEADLINE_CHECK_INTERVAL calls; meant for loops
+    // doing little work per call.
+    inline auto is_expired() -> bool {
+        if (!this->limited || this->expired) {
+            return this->expired;
+        }
+
+        if (--this->countdown > 0) {
+            return false;
+        }
+
+        this->countdown = DEADLINE_CHECK_INTERVAL;
+        return this->is_expired_now();
+    }
+
+    // Reads the clock on every call; meant for loops doing a lot of work per call.
+    auto is_expired_now() -> bool;
+};
+
+#endif // DEADLINE_H
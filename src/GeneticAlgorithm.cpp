@@ -0,0 +1,1139 @@
+#include "GeneticAlgorithm.h"
+#include "BatchEvaluation.h"
+#include "Deadline.h"
+#include "Instance.h"
+#include "Profile.h"
+#include "Random.h"
+#include "Solution.h"
+#include "SolutionFactory.h"
+#include "Statistics.h"
+#include "ThreadPool.h"
+#include "utils.h"
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <optional>
+#include <random>
+#include <thread>
+#include <vector>
+
+// Crossovers overwrite the two children and mutations change the solution in
+// place, so breeding reuses the genomes of the generation before last.
+using CrossoverCb = std::function<void(Solution &parent_a, Solution &parent_b, Random &rgen, Solution &child_a, Solution &child_b)>;
+using MutationCb = std::function<void(Solution &, Random &)>;
+
+auto calculate_fitness(int filled_bin_count) -> double {
+    return 1.0 / (1 + filled_bin_count);
+}
+
+// Genome together with its fitness, computed on first use and cached until
+// mutation replaces the genome.
+class Individual {
+private:
+    Solution solution;
+    double fitness;
+
+public:
+    explicit Individual(Solution solution)
+        : solution(std::move(solution)),
+          fitness(-1) {
+    }
+
+    auto get_solution() -> Solution & {
+        return this->solution;
+    }
+
+    auto get_fitness() -> double {
+        if (this->fitness < 0) {
+            this->fitness = calculate_fitness(this->solution.get_filled_bin_count());
+        }
+
+        return this->fitness;
+    }
+
+    auto has_fitness() -> bool {
+        return this->fitness >= 0;
+    }
+
+    auto set_filled_bin_count(int filled_bin_count) -> void {
+        this->fitness = calculate_fitness(filled_bin_count);
+    }
+
+    // Call after changing the solution returned by get_solution.
+    auto reset_fitness() -> void {
+        this->fitness = -1;
+    }
+
+    auto mutate(MutationCb &mutation_cb, Random &rgen) -> void {
+        mutation_cb(this->solution, rgen);
+        this->fitness = -1;
+    }
+};
+
+auto shuffle_bins(Solution &solution, Random &rgen) -> void;
+
+using Population = std::vector<Individual>;
+
+// Computes the missing fitness of the individuals in [first, last) with one
+// batch evaluation, every SIMD lane decoding another genome.
+auto evaluate_individuals(Population &population, int first, int last) -> void {
+    // Kept by the calling thread, so evaluating does not allocate once they have grown.
+    thread_local auto individuals = std::vector<Individual *>{};
+    thread_local auto genomes = std::vector<const Genome *>{};
+    thread_local auto filled_bin_counts = std::vector<int>{};
+
+    individuals.clear();
+    genomes.clear();
+
+    for (auto i = first; i < last; i++) {
+        if (!population[i].has_fitness()) {
+            individuals.push_back(&population[i]);
+            genomes.push_back(&population[i].get_solution().get_genome());
+        }
+    }
+
+    if (individuals.empty()) {
+        return;
+    }
+
+    filled_bin_counts.resize(individuals.size());
+    count_filled_bins_batch(
+        *individuals[0]->get_solution().get_instance(),
+        genomes.data(),
+        genomes.size(),
+        filled_bin_counts.data());
+
+    for (auto i = 0; i < (int)individuals.size(); i++) {
+        individuals[i]->set_filled_bin_count(filled_bin_counts[i]);
+    }
+}
+using EndingConditionCb = std::function<bool(Population &, int)>;
+
+using IslandOperators = std::pair<CrossoverCb, MutationCb>;
+// Island receiving the migrants of island `island_index`.
+using MigrationTargetCb = std::function<int(int island_index, int island_count, Random &rgen)>;
+
+// Generations between two migrations from an island.
+const auto MIGRATION_INTERVAL = 2;
+
+// Sub-population evolving on its own thread with its own operators.
+class Island {
+public:
+    Population population;
+    // Buffer the next generation is bred into before it is swapped with `population`.
+    Population next_population;
+    CrossoverCb crossover_cb;
+    MutationCb mutation_cb;
+    Random rgen;
+    // Latest migrant sent to this island, or null. Senders overwrite unread
+    // migrants, so a slow island only ever takes the freshest one.
+    std::atomic<Individual *> mailbox;
+
+    Island(Population population, IslandOperators operators, Random rgen)
+        : population(std::move(population)),
+          next_population(this->population),
+          crossover_cb(std::move(operators.first)),
+          mutation_cb(std::move(operators.second)),
+          rgen(rgen),
+          mailbox(nullptr) {
+    }
+
+    ~Island() {
+        delete this->mailbox.load();
+    }
+
+    auto send_migrant(Individual migrant) -> void {
+        delete this->mailbox.exchange(new Individual{std::move(migrant)}, std::memory_order_acq_rel);
+    }
+
+    // Replaces the least fit individual with the pending migrant, if any.
+    auto receive_migrant() -> void {
+        auto migrant = std::unique_ptr<Individual>{this->mailbox.exchange(nullptr, std::memory_order_acq_rel)};
+
+        if (!migrant) {
+            return;
+        }
+
+        auto &least_fit_individual = *std::min_element(
+            this->population.begin(),
+            this->population.end(),
+            [](auto &a, auto &b) {
+                return a.get_fitness() < b.get_fitness();
+            });
+
+        least_fit_individual = std::move(*migrant);
+    }
+};
+
+class GeneticSolutionFactory : public SolutionFactory {
+private:
+    // Percent of every initial population seeded from the start genome.
+    int seeded_percent;
+    // Set unless the pool is borrowed from a SolveWorkspace.
+    std::unique_ptr<ThreadPool> owned_thread_pool;
+    ThreadPool *thread_pool;
+    // Work is split into one chunk per thread and chunk `i` always draws from
+    // `chunk_rgens[i]`, so a seed and thread count reproduce the same run.
+    std::vector<Random> chunk_rgens;
+    Random rgen;
+
+    auto get_fittest_individual(Population &population) -> Individual & {
+        return *std::max_element(
+            population.begin(),
+            population.end(),
+            [](auto &a, auto &b) {
+                return a.get_fitness() < b.get_fitness();
+            });
+    }
+
+    auto get_chunk_count() -> int {
+        return this->chunk_rgens.size();
+    }
+
+    auto get_chunk_range(int chunk_index, int item_count) -> std::pair<int, int> {
+        auto chunk_count = this->get_chunk_count();
+
+        return {
+            (int)((long long)item_count * chunk_index / chunk_count),
+            (int)((long long)item_count * (chunk_index + 1) / chunk_count)};
+    }
+
+    auto generate_random_solution() -> Solution {
+        auto items = range(this->instance->get_item_count());
+        std::shuffle(items.begin(), items.end(), this->rgen);
+        return Solution{this->instance, Genome{items}};
+    }
+
+    // The seeded part of the population starts from the start genome with its bins
+    // shuffled; bins of a packing never overflow in any order, so next-fit decoding
+    // keeps at most as many bins while the genomes differ.
+    auto generate_population(int population_size) -> Population {
+        auto population = Population{};
+        auto seeded_count = population_size * this->seeded_percent / 100;
+
+        for (auto i : range(population_size)) {
+            if (i == 0 && seeded_count) {
+                population.emplace_back(Solution{this->instance, this->start_genome});
+            } else if (i < seeded_count) {
+                population.emplace_back(Solution{this->instance, this->start_genome});
+                shuffle_bins(population.back().get_solution(), this->rgen);
+            } else {
+                population.emplace_back(this->generate_random_solution());
+            }
+        }
+
+        this->evaluate_population(population);
+
+        return population;
+    }
+
+    auto evaluate_population(Population &population) -> void {
+        auto evaluation_counter = get_bound_evaluation_counter();
+        this->thread_pool->run_chunks(this->get_chunk_count(), [&](int chunk_index) {
+            auto evaluation_scope = EvaluationCountScope{evaluation_counter};
+            auto [first, last] = this->get_chunk_range(chunk_index, population.size());
+            [[maybe_unused]] auto phase_timer = ProfilePhaseTimer{ProfilePhase::EVALUATION};
+
+            evaluate_individuals(population, first, last);
+        });
+    }
+
+    auto select_parent(Population &population, Random &rgen) -> Solution & {
+        auto &individual_a = population[rgen.next_index(population.size())];
+        auto &individual_b = population[rgen.next_index(population.size())];
+
+        return individual_a.get_fitness() >= individual_b.get_fitness()
+                   ? individual_a.get_solution()
+                   : individual_b.get_solution();
+    }
+
+    // Selects, crosses, mutates and evaluates the offspring pairs [first_pair, last_pair),
+    // overwriting `offspring[2 * first_pair, 2 * last_pair)`.
+    auto breed_offspring(
+        Population &population,
+        int first_pair,
+        int last_pair,
+        CrossoverCb &crossover_cb,
+        MutationCb &mutation_cb,
+        Random &rgen,
+        Population &offspring)
+        -> void {
+        auto population_size = (int)population.size();
+
+        for (auto i = first_pair; i < last_pair; i++) {
+            auto phase_timer = ProfilePhaseTimer{ProfilePhase::SELECTION};
+
+            auto &parent_a = this->select_parent(population, rgen);
+            auto &parent_b = this->select_parent(population, rgen);
+
+            auto &child_a = offspring[2 * i];
+            auto has_child_b = 2 * i + 1 < population_size;
+
+            // The second child of an odd population's last pair is dropped, so it
+            // goes to a spare kept by the breeding thread, which may outlive the run.
+            thread_local auto spare_child = std::optional<Solution>{};
+            if (!has_child_b && (!spare_child || spare_child->get_instance() != parent_a.get_instance())) {
+                spare_child.emplace(parent_a);
+            }
+
+            phase_timer.switch_phase(ProfilePhase::CROSSOVER);
+
+            crossover_cb(
+                parent_a,
+                parent_b,
+                rgen,
+                child_a.get_solution(),
+                has_child_b ? offspring[2 * i + 1].get_solution() : *spare_child);
+
+            phase_timer.switch_phase(ProfilePhase::MUTATION);
+
+            child_a.mutate(mutation_cb, rgen);
+
+            if (has_child_b) {
+                offspring[2 * i + 1].mutate(mutation_cb, rgen);
+            }
+        }
+
+        [[maybe_unused]] auto phase_timer = ProfilePhaseTimer{ProfilePhase::EVALUATION};
+
+        evaluate_individuals(offspring, 2 * first_pair, std::min(2 * last_pair, population_size));
+    }
+
+    // Breeds the next generation into `offspring` in parallel chunks.
+    auto generate_offspring(
+        Population &population,
+        Population &offspring,
+        CrossoverCb &crossover_cb,
+        MutationCb &mutation_cb)
+        -> void {
+        auto pair_count = ((int)population.size() + 1) / 2;
+        auto evaluation_counter = get_bound_evaluation_counter();
+
+        this->thread_pool->run_chunks(this->get_chunk_count(), [&](int chunk_index) {
+            auto evaluation_scope = EvaluationCountScope{evaluation_counter};
+            auto [first, last] = this->get_chunk_range(chunk_index, pair_count);
+
+            this->breed_offspring(
+                population,
+                first,
+                last,
+                crossover_cb,
+                mutation_cb,
+                this->chunk_rgens[chunk_index],
+                offspring);
+        });
+    }
+
+public:
+    GeneticSolutionFactory(InstancePtr instance, int thread_count, Random rgen, SolveWorkspace *workspace)
+        : SolutionFactory(std::move(instance)),
+          seeded_percent(0),
+          owned_thread_pool(workspace ? nullptr : std::make_unique<ThreadPool>(thread_count)),
+          thread_pool(workspace ? &workspace->get_thread_pool(thread_count) : this->owned_thread_pool.get()),
+          rgen(rgen) {
+        for (auto i = 0; i < this->thread_pool->get_thread_count(); i++) {
+            this->chunk_rgens.push_back(this->rgen.split());
+        }
+    }
+
+    auto set_seeded_percent(int seeded_percent) -> void {
+        this->seeded_percent = std::clamp(seeded_percent, 0, 100);
+    }
+
+    auto generate_genetic_solution(
+        int population_size,
+        CrossoverCb &crossover_cb,
+        MutationCb &mutation_cb,
+        EndingConditionCb &ending_condition_cb)
+        -> Solution {
+
+        auto population = this->generate_population(population_size);
+        // Populations are double buffered: every generation is bred into the
+        // buffer of the one before last, so breeding does not allocate.
+        auto next_population = population;
+        auto generation_count = 0;
+
+        // Best individual of every generation so far, so a worse last generation does not lose it.
+        auto best_individual = this->get_fittest_individual(population);
+        this->report_new_best(best_individual.get_solution());
+
+        while (best_individual.get_solution().get_filled_bin_count() > this->lower_bound &&
+               !this->deadline.is_expired_now() &&
+               !ending_condition_cb(population, generation_count++)) {
+            this->generate_offspring(
+                population,
+                next_population,
+                crossover_cb,
+                mutation_cb);
+            std::swap(population, next_population);
+
+            auto &fittest_individual = this->get_fittest_individual(population);
+
+            if (fittest_individual.get_fitness() > best_individual.get_fitness()) {
+                best_individual = fittest_individual;
+                this->report_new_best(best_individual.get_solution());
+            }
+        }
+
+        return best_individual.get_solution();
+    }
+
+    // Island model: every island evolves its own population on its own thread and
+    // sends its fittest individual to `migration_target_cb`'s island every
+    // MIGRATION_INTERVAL generations, without waiting for the others. Migration
+    // timing depends on thread scheduling, so runs are not reproducible.
+    auto generate_island_solution(
+        int population_size,
+        std::vector<IslandOperators> &island_operators,
+        EndingConditionCb &ending_condition_cb,
+        MigrationTargetCb &migration_target_cb)
+        -> Solution {
+        auto island_count = (int)island_operators.size();
+
+        auto islands = std::vector<std::unique_ptr<Island>>{};
+        for (auto &operators : island_operators) {
+            islands.push_back(std::make_unique<Island>(
+                this->generate_population(population_size),
+                operators,
+                this->rgen.split()));
+        }
+
+        auto best_mutex = std::mutex{};
+        auto best_individual = this->get_fittest_individual(islands[0]->population);
+        this->report_new_best(best_individual.get_solution());
+        // Lets islands check for the lower bound without the lock.
+        auto best_filled_bin_count = std::atomic<int>{best_individual.get_solution().get_filled_bin_count()};
+
+        auto offer_best = [&](Individual &individual) {
+            auto lock = std::unique_lock<std::mutex>{best_mutex};
+
+            if (individual.get_fitness() > best_individual.get_fitness()) {
+                best_individual = individual;
+                best_filled_bin_count.store(best_individual.get_solution().get_filled_bin_count(), std::memory_order_relaxed);
+                this->report_new_best(best_individual.get_solution());
+            }
+        };
+
+        auto evaluation_counter = get_bound_evaluation_counter();
+        auto threads = std::vector<std::thread>{};
+        for (auto island_index : range(island_count)) {
+            threads.emplace_back([&, island_index]() {
+                auto evaluation_scope = EvaluationCountScope{evaluation_counter};
+                auto &island = *islands[island_index];
+                auto &population = island.population;
+                auto pair_count = ((int)population.size() + 1) / 2;
+                auto generation_count = 0;
+                auto deadline = this->deadline;
+
+                offer_best(this->get_fittest_individual(population));
+
+                while (best_filled_bin_count.load(std::memory_order_relaxed) > this->lower_bound &&
+                       !deadline.is_expired_now() &&
+                       !ending_condition_cb(population, generation_count++)) {
+                    this->breed_offspring(
+                        population,
+                        0,
+                        pair_count,
+                        island.crossover_cb,
+                        island.mutation_cb,
+                        island.rgen,
+                        island.next_population);
+
+                    std::swap(population, island.next_population);
+                    island.receive_migrant();
+
+                    auto &fittest_individual = this->get_fittest_individual(population);
+                    offer_best(fittest_individual);
+
+                    if (island_count > 1 && generation_count % MIGRATION_INTERVAL == 0) {
+                        auto target_index = migration_target_cb(island_index, island_count, island.rgen);
+                        islands[target_index]->send_migrant(fittest_individual);
+                    }
+                }
+            });
+        }
+
+        for (auto &thread : threads) {
+            thread.join();
+        }
+
+        return best_individual.get_solution();
+    }
+};
+
+using Items = std::vector<int>;
+
+auto copy_genome_items(const Genome &genome, Items &items) -> void {
+    genome.visit([&](auto *genome_items, int size) {
+        items.assign(genome_items, genome_items + size);
+    });
+}
+
+// Scratch buffers of the crossover operators. Every breeding thread reuses its
+// own instance, so crossing does not allocate once the buffers have grown.
+class Crossover {
+public:
+    // Not owned, so a thread outliving the run does not keep its instance alive.
+    const Instance *instance = nullptr;
+    Items parent_items_a;
+    Items parent_items_b;
+    Items child_items_a;
+    Items child_items_b;
+    std::vector<bool> used_child_items_a;
+    std::vector<bool> used_child_items_b;
+    // Index of every item in parent_items_a.
+    Items item_indexes_a;
+    // Index of every item in parent_items_b.
+    Items item_indexes_b;
+    Items merged_items;
+    std::vector<bool> kept_positions;
+    // Next-fit bin starts of parent_items_a, followed by the item count.
+    Items bin_starts_a;
+    // Next-fit bin starts of parent_items_b, followed by the item count.
+    Items bin_starts_b;
+
+    static auto get_thread_crossover(Solution &parent_a, Solution &parent_b) -> Crossover & {
+        thread_local auto crossover = Crossover{};
+        crossover.reset(parent_a, parent_b);
+        return crossover;
+    }
+
+    auto reset(Solution &parent_a, Solution &parent_b) -> void {
+        this->instance = parent_a.get_instance().get();
+        copy_genome_items(parent_a.get_genome(), this->parent_items_a);
+        copy_genome_items(parent_b.get_genome(), this->parent_items_b);
+
+        auto item_count = (int)this->parent_items_a.size();
+        this->child_items_a.clear();
+        this->child_items_b.clear();
+        this->used_child_items_a.assign(item_count, false);
+        this->used_child_items_b.assign(item_count, false);
+    }
+
+    auto get_item_count() -> int {
+        return this->parent_items_a.size();
+    }
+
+    auto index_parent_items() -> void {
+        auto item_count = this->get_item_count();
+        this->item_indexes_a.resize(item_count);
+        this->item_indexes_b.resize(item_count);
+
+        for (auto i = 0; i < item_count; i++) {
+            this->item_indexes_a[this->parent_items_a[i]] = i;
+            this->item_indexes_b[this->parent_items_b[i]] = i;
+        }
+    }
+
+    // Decodes the bins here rather than through the parents' caches, as other
+    // breeding threads may be reading the same parents.
+    auto find_bin_starts(const Items &items, Items &bin_starts) -> void {
+        auto weights = this->instance->get_weights();
+        auto bin_weight_limit = this->instance->get_bin_weight_limit();
+        auto weight_in_last_bin = 0;
+
+        bin_starts.assign(1, 0);
+
+        for (auto i = 0; i < (int)items.size(); i++) {
+            auto bag_weight = weights[items[i]];
+
+            if (i && weight_in_last_bin + bag_weight > bin_weight_limit) {
+                bin_starts.push_back(i);
+                weight_in_last_bin = 0;
+            }
+
+            weight_in_last_bin += bag_weight;
+        }
+
+        bin_starts.push_back(items.size());
+    }
+
+    auto index_parent_bins() -> void {
+        this->find_bin_starts(this->parent_items_a, this->bin_starts_a);
+        this->find_bin_starts(this->parent_items_b, this->bin_starts_b);
+    }
+
+    auto insert_to_child_items_a(int item) -> void {
+        if (!this->used_child_items_a[item]) {
+            this->used_child_items_a[item] = true;
+            this->child_items_a.push_back(item);
+        }
+    }
+
+    auto insert_to_child_items_b(int item) -> void {
+        if (!this->used_child_items_b[item]) {
+            this->used_child_items_b[item] = true;
+            this->child_items_b.push_back(item);
+        }
+    }
+
+    // Puts every missing item at its index in the parent, shifting the items
+    // after it; missing items are merged in ascending index order.
+    auto complete_child_items(
+        Items &child_items,
+        std::vector<bool> &used_child_items,
+        const Items &parent_items)
+        -> void {
+        auto &merged_items = this->merged_items;
+        merged_items.clear();
+
+        auto child_index = 0;
+        auto child_size = (int)child_items.size();
+
+        for (auto parent_index = 0; parent_index < (int)parent_items.size(); parent_index++) {
+            auto item = parent_items[parent_index];
+
+            if (used_child_items[item]) {
+                continue;
+            }
+
+            while ((int)merged_items.size() < parent_index && child_index < child_size) {
+                merged_items.push_back(child_items[child_index++]);
+            }
+
+            used_child_items[item] = true;
+            merged_items.push_back(item);
+        }
+
+        merged_items.insert(merged_items.end(), child_items.begin() + child_index, child_items.end());
+        std::swap(child_items, merged_items);
+    }
+
+    auto complete_child_items_based_on_parents() -> void {
+        this->complete_child_items(this->child_items_a, this->used_child_items_a, this->parent_items_a);
+        this->complete_child_items(this->child_items_b, this->used_child_items_b, this->parent_items_b);
+    }
+
+    // Order crossover: the child keeps `parent_items[first, last)` in place and
+    // fills the other positions with the missing items in `other_parent_items`
+    // order, starting after the segment.
+    static auto cross_ordered(
+        const Items &parent_items,
+        const Items &other_parent_items,
+        int first,
+        int last,
+        Items &child_items,
+        std::vector<bool> &used_child_items)
+        -> void {
+        auto item_count = (int)parent_items.size();
+        child_items.resize(item_count);
+
+        for (auto i = first; i < last; i++) {
+            child_items[i] = parent_items[i];
+            used_child_items[parent_items[i]] = true;
+        }
+
+        auto child_index = last;
+        for (auto i = 0; i < item_count; i++) {
+            auto item = other_parent_items[(last + i) % item_count];
+
+            if (!used_child_items[item]) {
+                used_child_items[item] = true;
+                child_items[child_index++ % item_count] = item;
+            }
+        }
+    }
+
+    // Partially mapped crossover: the child keeps `parent_items[first, last)`
+    // in place and takes every other position from `other_parent_items`,
+    // following the segment's mapping when that item is already used.
+    static auto cross_partially_mapped(
+        const Items &parent_items,
+        const Items &other_parent_items,
+        const Items &item_indexes,
+        int first,
+        int last,
+        Items &child_items,
+        std::vector<bool> &used_child_items)
+        -> void {
+        auto item_count = (int)parent_items.size();
+        child_items.resize(item_count);
+
+        for (auto i = first; i < last; i++) {
+            child_items[i] = parent_items[i];
+            used_child_items[parent_items[i]] = true;
+        }
+
+        for (auto i = 0; i < item_count; i++) {
+            if (i >= first && i < last) {
+                continue;
+            }
+
+            auto item = other_parent_items[i];
+
+            // Mapping chains are disjoint, so all of them take O(n) together.
+            while (used_child_items[item]) {
+                item = other_parent_items[item_indexes[item]];
+            }
+
+            child_items[i] = item;
+        }
+    }
+
+    // Position based crossover: the child keeps `parent_items` at the positions
+    // whose `kept_positions` bit is set and fills the others with the missing
+    // items in `other_parent_items` order.
+    static auto cross_position_based(
+        const Items &parent_items,
+        const Items &other_parent_items,
+        const std::vector<bool> &kept_positions,
+        Items &child_items,
+        std::vector<bool> &used_child_items)
+        -> void {
+        auto item_count = (int)parent_items.size();
+        child_items.resize(item_count);
+
+        for (auto i = 0; i < item_count; i++) {
+            if (kept_positions[i]) {
+                child_items[i] = parent_items[i];
+                used_child_items[parent_items[i]] = true;
+            }
+        }
+
+        auto other_index = 0;
+        for (auto i = 0; i < item_count; i++) {
+            if (kept_positions[i]) {
+                continue;
+            }
+
+            while (used_child_items[other_parent_items[other_index]]) {
+                other_index++;
+            }
+
+            child_items[i] = other_parent_items[other_index++];
+        }
+    }
+
+    auto write_children(Solution &child_a, Solution &child_b) -> void {
+        child_a.set_items(this->child_items_a);
+        child_b.set_items(this->child_items_b);
+    }
+};
+
+// Random segment [first, last) of `item_count` positions.
+auto generate_random_segment(int item_count, Random &rgen) -> std::pair<int, int> {
+    auto first = rgen.next_index(item_count);
+    auto last = rgen.next_index(item_count);
+
+    if (first > last) {
+        std::swap(first, last);
+    }
+
+    return {first, last + 1};
+}
+
+auto cross_parents_into_striped_bags_children(
+    Solution &parent_a,
+    Solution &parent_b,
+    Random &,
+    Solution &child_a,
+    Solution &child_b)
+    -> void {
+    auto &crossover = Crossover::get_thread_crossover(parent_a, parent_b);
+
+    for (auto i = 0; i < crossover.get_item_count(); i++) {
+        if (i % 2) {
+            crossover.insert_to_child_items_a(crossover.parent_items_a[i]);
+            crossover.insert_to_child_items_b(crossover.parent_items_b[i]);
+        } else {
+            crossover.insert_to_child_items_a(crossover.parent_items_b[i]);
+            crossover.insert_to_child_items_b(crossover.parent_items_a[i]);
+        }
+    }
+
+    crossover.complete_child_items_based_on_parents();
+
+    crossover.write_children(child_a, child_b);
+}
+
+auto cross_parents_into_striped_bins_children(
+    Solution &parent_a,
+    Solution &parent_b,
+    Random &,
+    Solution &child_a,
+    Solution &child_b)
+    -> void {
+    auto &crossover = Crossover::get_thread_crossover(parent_a, parent_b);
+
+    crossover.index_parent_bins();
+
+    auto bin_count_a = (int)crossover.bin_starts_a.size() - 1;
+    auto bin_count_b = (int)crossover.bin_starts_b.size() - 1;
+
+    auto a_is_primary = bin_count_a > bin_count_b;
+    auto &primary_items = a_is_primary ? crossover.parent_items_a : crossover.parent_items_b;
+    auto &primary_bin_starts = a_is_primary ? crossover.bin_starts_a : crossover.bin_starts_b;
+    auto &secondary_items = a_is_primary ? crossover.parent_items_b : crossover.parent_items_a;
+    auto &secondary_bin_starts = a_is_primary ? crossover.bin_starts_b : crossover.bin_starts_a;
+    auto secondary_bin_count = a_is_primary ? bin_count_b : bin_count_a;
+
+    for (auto i = 0; i < std::max(bin_count_a, bin_count_b); i++) {
+        for (auto j = primary_bin_starts[i]; j < primary_bin_starts[i + 1]; j++) {
+            if (i % 2) {
+                crossover.insert_to_child_items_a(primary_items[j]);
+            } else {
+                crossover.insert_to_child_items_b(primary_items[j]);
+            }
+        }
+
+        if (i < secondary_bin_count) {
+            for (auto j = secondary_bin_starts[i]; j < secondary_bin_starts[i + 1]; j++) {
+                if (i % 2) {
+                    crossover.insert_to_child_items_b(secondary_items[j]);
+                } else {
+                    crossover.insert_to_child_items_a(secondary_items[j]);
+                }
+            }
+        }
+    }
+
+    crossover.complete_child_items_based_on_parents();
+
+    crossover.write_children(child_a, child_b);
+}
+
+auto cross_parents_into_ordered_children(
+    Solution &parent_a,
+    Solution &parent_b,
+    Random &rgen,
+    Solution &child_a,
+    Solution &child_b)
+    -> void {
+    auto &crossover = Crossover::get_thread_crossover(parent_a, parent_b);
+    auto [first, last] = generate_random_segment(crossover.get_item_count(), rgen);
+
+    Crossover::cross_ordered(
+        crossover.parent_items_a,
+        crossover.parent_items_b,
+        first,
+        last,
+        crossover.child_items_a,
+        crossover.used_child_items_a);
+    Crossover::cross_ordered(
+        crossover.parent_items_b,
+        crossover.parent_items_a,
+        first,
+        last,
+        crossover.child_items_b,
+        crossover.used_child_items_b);
+
+    crossover.write_children(child_a, child_b);
+}
+
+auto cross_parents_into_partially_mapped_children(
+    Solution &parent_a,
+    Solution &parent_b,
+    Random &rgen,
+    Solution &child_a,
+    Solution &child_b)
+    -> void {
+    auto &crossover = Crossover::get_thread_crossover(parent_a, parent_b);
+    auto [first, last] = generate_random_segment(crossover.get_item_count(), rgen);
+
+    crossover.index_parent_items();
+
+    Crossover::cross_partially_mapped(
+        crossover.parent_items_a,
+        crossover.parent_items_b,
+        crossover.item_indexes_a,
+        first,
+        last,
+        crossover.child_items_a,
+        crossover.used_child_items_a);
+    Crossover::cross_partially_mapped(
+        crossover.parent_items_b,
+        crossover.parent_items_a,
+        crossover.item_indexes_b,
+        first,
+        last,
+        crossover.child_items_b,
+        crossover.used_child_items_b);
+
+    crossover.write_children(child_a, child_b);
+}
+
+auto cross_parents_into_position_based_children(
+    Solution &parent_a,
+    Solution &parent_b,
+    Random &rgen,
+    Solution &child_a,
+    Solution &child_b)
+    -> void {
+    auto &crossover = Crossover::get_thread_crossover(parent_a, parent_b);
+    auto item_count = crossover.get_item_count();
+
+    auto &kept_positions = crossover.kept_positions;
+    kept_positions.resize(item_count);
+
+    for (auto i = 0; i < item_count; i += 64) {
+        auto bits = rgen();
+
+        for (auto j = i; j < std::min(i + 64, item_count); j++) {
+            kept_positions[j] = bits & 1;
+            bits >>= 1;
+        }
+    }
+
+    Crossover::cross_position_based(
+        crossover.parent_items_a,
+        crossover.parent_items_b,
+        kept_positions,
+        crossover.child_items_a,
+        crossover.used_child_items_a);
+    Crossover::cross_position_based(
+        crossover.parent_items_b,
+        crossover.parent_items_a,
+        kept_positions,
+        crossover.child_items_b,
+        crossover.used_child_items_b);
+
+    crossover.write_children(child_a, child_b);
+}
+
+auto swap_random_adjacent_bags(Solution &solution, Random &rgen) -> void {
+    solution.apply_move(solution.generate_random_move(rgen));
+}
+
+auto shuffle_bins(Solution &solution, Random &rgen) -> void {
+    // Reused by every call on the thread, like the crossover buffers.
+    thread_local auto items = Items{};
+    thread_local auto bin_order = Items{};
+    thread_local auto new_items = Items{};
+
+    copy_genome_items(solution.get_genome(), items);
+
+    auto &bin_starts = solution.get_bin_starts();
+    auto bin_count = (int)bin_starts.size();
+
+    bin_order.resize(bin_count);
+    std::iota(bin_order.begin(), bin_order.end(), 0);
+    std::shuffle(bin_order.begin(), bin_order.end(), rgen);
+
+    new_items.clear();
+    for (auto bin_index : bin_order) {
+        auto last = bin_index + 1 < bin_count ? bin_starts[bin_index + 1] : (int)items.size();
+        new_items.insert(new_items.end(), items.begin() + bin_starts[bin_index], items.begin() + last);
+    }
+
+    solution.set_items(new_items);
+}
+
+auto migrate_on_ring(int island_index, int island_count, Random &) -> int {
+    return (island_index + 1) % island_count;
+}
+
+auto migrate_to_random_island(int island_index, int island_count, Random &rgen) -> int {
+    return (island_index + 1 + rgen.next_index(island_count - 1)) % island_count;
+}
+
+const auto GENERATION_COUNT_LIMIT = 10;
+
+auto end_on_generation_count_limit(Population &, int generation_count) -> bool {
+    return generation_count++ >= GENERATION_COUNT_LIMIT;
+}
+
+const auto SAME_FITNESS_POPULATION_PERCENT_THRESHOLD = 70;
+
+auto end_on_undifferentiated_population(Population &population, int) -> bool {
+    // Sorted rather than counted in a map, so checking does not allocate.
+    thread_local auto fitnesses = std::vector<double>{};
+
+    auto solution_count_threshold = (int)population.size() * SAME_FITNESS_POPULATION_PERCENT_THRESHOLD / 100;
+
+    fitnesses.clear();
+    for (auto &individual : population) {
+        fitnesses.push_back(individual.get_fitness());
+    }
+
+    std::sort(fitnesses.begin(), fitnesses.end());
+
+    auto first = 0;
+    for (auto i = 0; i < (int)fitnesses.size(); i++) {
+        if (fitnesses[i] != fitnesses[first]) {
+            first = i;
+        }
+
+        if (i - first + 1 >= solution_count_threshold) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+const auto CROSSOVER_CB_MAP = std::map<int, CrossoverCb>{
+    {1, cross_parents_into_striped_bags_children},
+    {2, cross_parents_into_striped_bins_children},
+    {3, cross_parents_into_ordered_children},
+    {4, cross_parents_into_partially_mapped_children},
+    {5, cross_parents_into_position_based_children},
+};
+
+const auto MUTATION_CB_MAP = std::map<int, MutationCb>{
+    {1, swap_random_adjacent_bags},
+    {2, shuffle_bins},
+};
+
+const auto MIGRATION_TARGET_CB_MAP = std::map<int, MigrationTargetCb>{
+    {1, migrate_on_ring},
+    {2, migrate_to_random_island},
+};
+
+const auto ENDING_CONDITION_CB_MAP = std::map<int, EndingConditionCb>{
+    {1, end_on_generation_count_limit},
+    {2, end_on_undifferentiated_population},
+};
+
+static auto solve_with_genetic_algorithm(
+    InstancePtr instance,
+    const std::vector<int> &args,
+    const Options &options,
+    const SolveBudget &budget,
+    NewBestCb new_best_cb)
+    -> SolveResult {
+    auto seed = resolve_seed(std::stoull(options.at("seed")));
+    auto solution_factory = GeneticSolutionFactory{std::move(instance), args[4], Random{seed}, budget.workspace};
+
+    auto statistics = RunStatistics{solution_factory.get_lower_bound()};
+    auto evaluation_scope = EvaluationCountScope{statistics.get_evaluation_counter()};
+    solution_factory.set_new_best_cb(make_new_best_cb(statistics, std::move(new_best_cb)));
+    solution_factory.set_deadline(Deadline{budget.time_limit_ms, budget.cancelled});
+    solution_factory.set_start(options.at("start"));
+    if (options.at("start") != "instance") {
+        solution_factory.set_seeded_percent(get_int_option(options, "seeded-percent"));
+    }
+
+    // The callbacks are copied, as runs on other threads may call the same ones.
+    auto ending_condition_cb = ENDING_CONDITION_CB_MAP.at(args[3]);
+
+    auto solutions = std::vector<LabelledSolution>{};
+
+    if (args[5] > 1) {
+        auto operator_pairs = std::vector<IslandOperators>{};
+        if (args[7] == 2) {
+            for (auto &[_, crossover_cb] : CROSSOVER_CB_MAP) {
+                for (auto &[_, mutation_cb] : MUTATION_CB_MAP) {
+                    operator_pairs.emplace_back(crossover_cb, mutation_cb);
+                }
+            }
+        } else {
+            operator_pairs.emplace_back(CROSSOVER_CB_MAP.at(args[1]), MUTATION_CB_MAP.at(args[2]));
+        }
+
+        auto island_operators = std::vector<IslandOperators>{};
+        for (auto i : range(args[5])) {
+            island_operators.push_back(operator_pairs[i % operator_pairs.size()]);
+        }
+
+        auto migration_target_cb = MIGRATION_TARGET_CB_MAP.at(args[6]);
+
+        solutions.push_back({
+            "Island genetic solution",
+            solution_factory.generate_island_solution(
+                args[0],
+                island_operators,
+                ending_condition_cb,
+                migration_target_cb),
+        });
+    } else {
+        auto crossover_cb = CROSSOVER_CB_MAP.at(args[1]);
+        auto mutation_cb = MUTATION_CB_MAP.at(args[2]);
+
+        solutions.push_back({
+            "Genetic solution",
+            solution_factory.generate_genetic_solution(
+                args[0],
+                crossover_cb,
+                mutation_cb,
+                ending_condition_cb),
+        });
+    }
+
+    statistics.finish();
+
+    return SolveResult{std::move(solutions), statistics, seed};
+}
+
+auto get_genetic_algorithm_spec() -> AlgorithmSpec {
+    auto expected_options = get_solver_options();
+    expected_options.push_back({
+        "seeded-percent",
+        "Percent of every initial population seeded from the --start solution, unless it is instance",
+        "10",
+    });
+
+    return AlgorithmSpec{
+        {
+            {
+                "Population size",
+                "",
+                {},
+                100,
+                1,
+            },
+            {
+                "Crossover method",
+                "- 1 -> Bag striping"
+                "\n   - 2 -> Bin striping"
+                "\n   - 3 -> Order crossover (OX)"
+                "\n   - 4 -> Partially mapped crossover (PMX)"
+                "\n   - 5 -> Position based crossover",
+                {map_keys_to_set(CROSSOVER_CB_MAP)},
+                1,
+            },
+            {
+                "Mutation method",
+                "- 1 -> Swap random adjacent bag pair"
+                "\n   - 2 -> Shuffle bins",
+                {map_keys_to_set(MUTATION_CB_MAP)},
+                1,
+            },
+            {
+                "Ending condition",
+                "- 1 -> Generation count limit"
+                " (" +
+                    std::to_string(GENERATION_COUNT_LIMIT) + ")"
+                                                             "\n   - 2 -> Majority of the population has the same fitness"
+                                                             " (threshold: " +
+                    std::to_string(SAME_FITNESS_POPULATION_PERCENT_THRESHOLD) + "%)",
+                {map_keys_to_set(ENDING_CONDITION_CB_MAP)},
+                1,
+            },
+            {
+                "Thread count",
+                "Thread count not greater than 0 means one thread per hardware thread;"
+                " results are reproducible for a given seed and thread count",
+                {},
+                0,
+            },
+            {
+                "Island count",
+                "Above 1 -> island model, every island of the given population size on its own thread",
+                {},
+                1,
+            },
+            {
+                "Migration topology",
+                "- 1 -> Ring"
+                "\n   - 2 -> Random island",
+                {map_keys_to_set(MIGRATION_TARGET_CB_MAP)},
+                1,
+            },
+            {
+                "Island operators",
+                "- 1 -> Selected crossover and mutation methods on every island"
+                "\n   - 2 -> Islands take turns with every crossover and mutation method pair",
+                {1, 2},
+                1,
+            },
+        },
+        expected_options,
+        true,
+        solve_with_genetic_algorithm,
+    };
+}
@@ -0,0 +1,9 @@
+#include "Solver.h"
+
+#ifndef GENETIC_ALGORITHM_H
+#define GENETIC_ALGORITHM_H
+
+// Spec of the "genetic-algorithm" algorithm of solve().
+auto get_genetic_algorithm_spec() -> AlgorithmSpec;
+
+#endif // GENETIC_ALGORITHM_H
@@ -0,0 +1,75 @@
+#include "Genome.h"
+#include "Profile.h"
+#include "utils.h"
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <variant>
+#include <vector>
+
+template <typename Index>
+auto pack_items(const std::vector<int> &items) -> std::vector<Index> {
+    profile_count(ProfileCounter::GENOME_ALLOCATIONS);
+
+    auto packed = std::vector<Index>{};
+    packed.reserve(items.size());
+
+    for (auto item : items) {
+        packed.push_back((Index)item);
+    }
+
+    return packed;
+}
+
+Genome::Genome(int item_count)
+    : Genome(range(item_count)) {
+}
+
+Genome::Genome(const std::vector<int> &items) {
+    if ((int)items.size() <= NARROW_GENOME_ITEM_COUNT_LIMIT) {
+        this->items = pack_items<std::uint16_t>(items);
+    } else {
+        this->items = pack_items<std::uint32_t>(items);
+    }
+}
+
+auto Genome::get_size() const -> int {
+    return this->visit([](auto, int size) { return size; });
+}
+
+auto Genome::get_item(int index) const -> int {
+    return this->visit([&](auto items, int) { return (int)items[index]; });
+}
+
+auto Genome::swap_items(int index1, int index2) -> void {
+    this->visit([&](auto items, int) { std::swap(items[index1], items[index2]); });
+}
+
+auto Genome::rotate_items(int first, int middle, int last) -> void {
+    this->visit([&](auto items, int) { std::rotate(items + first, items + middle, items + last); });
+}
+
+auto Genome::to_vector() const -> std::vector<int> {
+    return this->visit([](auto items, int size) {
+        return std::vector<int>(items, items + size);
+    });
+}
+
+auto Genome::assign_items(const std::vector<int> &items) -> void {
+    auto is_narrow = (int)items.size() <= NARROW_GENOME_ITEM_COUNT_LIMIT;
+
+    if (is_narrow != std::holds_alternative<std::vector<std::uint16_t>>(this->items)) {
+        *this = Genome{items};
+        return;
+    }
+
+    std::visit(
+        [&](auto &packed) {
+            if (packed.capacity() < items.size()) {
+                profile_count(ProfileCounter::GENOME_ALLOCATIONS);
+            }
+
+            packed.assign(items.begin(), items.end());
+        },
+        this->items);
+}
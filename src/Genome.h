@@ -0,0 +1,65 @@
+#include <cstdint>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#ifndef GENOME_H
+#define GENOME_H
+
+// Largest item count whose indexes fit into the narrow genome representation.
+const auto NARROW_GENOME_ITEM_COUNT_LIMIT = 1 << 16;
+
+// Permutation of item indexes into the shared instance. Indexes are stored as
+// uint16_t when the instance is small enough and as uint32_t otherwise.
+class Genome {
+private:
+    std::variant<std::vector<std::uint16_t>, std::vector<std::uint32_t>> items;
+
+public:
+    // Identity permutation of `item_count` items.
+    explicit Genome(int item_count);
+
+    explicit Genome(const std::vector<int> &items);
+
+    auto get_size() const -> int;
+
+    auto get_item(int index) const -> int;
+
+    auto swap_items(int index1, int index2) -> void;
+
+    // std::rotate of the items in [first, last): the one at `middle` becomes the first.
+    auto rotate_items(int first, int middle, int last) -> void;
+
+    auto to_vector() const -> std::vector<int>;
+
+    // Replaces the permutation, reusing the current storage while the width fits.
+    auto assign_items(const std::vector<int> &items) -> void;
+
+    // Packed indexes when they are stored as `Index`, otherwise null.
+    template <typename Index>
+    inline auto get_packed_items() const -> const Index * {
+        auto packed = std::get_if<std::vector<Index>>(&this->items);
+        return packed ? packed->data() : nullptr;
+    }
+
+    // Calls `cb(items, size)` with a typed pointer to the packed indexes.
+    template <typename Cb>
+    inline auto visit(Cb &&cb) const {
+        return std::visit(
+            [&](auto &items) {
+                return cb(items.data(), (int)items.size());
+            },
+            this->items);
+    }
+
+    template <typename Cb>
+    inline auto visit(Cb &&cb) {
+        return std::visit(
+            [&](auto &items) {
+                return cb(items.data(), (int)items.size());
+            },
+            this->items);
+    }
+};
+
+#endif // GENOME_H
@@ -0,0 +1,114 @@
+#include "HashSet.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Slot value marking an empty slot; the key itself is tracked by `has_empty_key`.
+const auto EMPTY_KEY = std::uint64_t{0};
+
+static auto mix_hash(std::uint64_t key) -> std::uint64_t {
+    key ^= key >> 33;
+    key *= 0xff51afd7ed558ccdULL;
+    key ^= key >> 33;
+    return key;
+}
+
+HashSet::HashSet(int initial_capacity)
+    : size(0),
+      has_empty_key(false) {
+    auto capacity = std::size_t{16};
+    while (capacity < (std::size_t)initial_capacity * 2) {
+        capacity *= 2;
+    }
+
+    this->slots.assign(capacity, EMPTY_KEY);
+}
+
+// Index of the slot holding `key`, or of the empty slot ending its probe sequence.
+auto HashSet::find_slot(std::uint64_t key) const -> int {
+    auto mask = (int)this->slots.size() - 1;
+    auto index = (int)(mix_hash(key) & mask);
+
+    while (this->slots[index] != EMPTY_KEY && this->slots[index] != key) {
+        index = (index + 1) & mask;
+    }
+
+    return index;
+}
+
+auto HashSet::grow() -> void {
+    auto old_slots = std::move(this->slots);
+    this->slots.assign(old_slots.size() * 2, EMPTY_KEY);
+
+    for (auto key : old_slots) {
+        if (key != EMPTY_KEY) {
+            this->slots[this->find_slot(key)] = key;
+        }
+    }
+}
+
+auto HashSet::contains(std::uint64_t key) const -> bool {
+    if (key == EMPTY_KEY) {
+        return this->has_empty_key;
+    }
+
+    return this->slots[this->find_slot(key)] == key;
+}
+
+auto HashSet::insert(std::uint64_t key) -> void {
+    if (key == EMPTY_KEY) {
+        this->size += !this->has_empty_key;
+        this->has_empty_key = true;
+        return;
+    }
+
+    auto index = this->find_slot(key);
+    if (this->slots[index] == key) {
+        return;
+    }
+
+    this->slots[index] = key;
+    this->size++;
+
+    // Keep the load factor at or below 1/2 so probe sequences stay short.
+    if (this->size * 2 > (int)this->slots.size()) {
+        this->grow();
+    }
+}
+
+// Backward-shift deletion: no tombstones, so lookups never slow down after evictions.
+auto HashSet::erase(std::uint64_t key) -> void {
+    if (key == EMPTY_KEY) {
+        this->size -= this->has_empty_key;
+        this->has_empty_key = false;
+        return;
+    }
+
+    auto index = this->find_slot(key);
+    if (this->slots[index] != key) {
+        return;
+    }
+
+    auto mask = (int)this->slots.size() - 1;
+    auto hole = index;
+    auto next = (hole + 1) & mask;
+
+    while (this->slots[next] != EMPTY_KEY) {
+        auto home = (int)(mix_hash(this->slots[next]) & mask);
+
+        // Move the entry back unless its home lies cyclically in (hole, next].
+        auto stays = hole <= next
+                         ? (hole < home && home <= next)
+                         : (hole < home || home <= next);
+
+        if (!stays) {
+            this->slots[hole] = this->slots[next];
+            hole = next;
+        }
+
+        next = (next + 1) & mask;
+    }
+
+    this->slots[hole] = EMPTY_KEY;
+    this->size--;
+}
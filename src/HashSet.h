@@ -0,0 +1,32 @@
+#include <cstdint>
+#include <vector>
+
+#ifndef HASH_SET_H
+#define HASH_SET_H
+
+// Open-addressing (linear probing) set of 64-bit hashes.
+class HashSet {
+private:
+    std::vector<std::uint64_t> slots;
+    int size;
+    bool has_empty_key;
+
+    auto find_slot(std::uint64_t key) const -> int;
+
+    auto grow() -> void;
+
+public:
+    explicit HashSet(int initial_capacity = 16);
+
+    auto contains(std::uint64_t key) const -> bool;
+
+    auto insert(std::uint64_t key) -> void;
+
+    auto erase(std::uint64_t key) -> void;
+
+    inline auto get_size() const -> int {
+        return this->size;
+    }
+};
+
+#endif // HASH_SET_H
@@ -0,0 +1,278 @@
+#include "HillClimbing.h"
+#include "Deadline.h"
+#include "Instance.h"
+#include "Neighborhood.h"
+#include "Profile.h"
+#include "Random.h"
+#include "Solution.h"
+#include "SolutionFactory.h"
+#include "Statistics.h"
+#include "TrajectoryEngine.h"
+#include "WorkStealingPool.h"
+#include "utils.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include <vector>
+
+// Best solution shared by concurrent climbs. Candidates are ranked by a packed
+// (filled bin count, restart index) key, which is read lock-free, so climbs that
+// cannot improve never take the lock, and ties go to the lowest restart index
+// whatever the thread timing.
+class BestSolutionSlot {
+private:
+    std::atomic<std::uint64_t> best_key;
+    std::mutex mutex;
+    std::optional<Solution> solution;
+    NewBestCb new_best_cb;
+
+public:
+    explicit BestSolutionSlot(NewBestCb new_best_cb)
+        : best_key(std::numeric_limits<std::uint64_t>::max()),
+          new_best_cb(std::move(new_best_cb)) {
+    }
+
+    static inline auto get_key(int filled_bin_count, int restart_index) -> std::uint64_t {
+        return (std::uint64_t)filled_bin_count << 32 | (std::uint32_t)restart_index;
+    }
+
+    // Lock-free; the maximum int while the slot is empty.
+    auto get_filled_bin_count() -> int {
+        auto key = this->best_key.load(std::memory_order_acquire);
+        return key == std::numeric_limits<std::uint64_t>::max() ? std::numeric_limits<int>::max() : (int)(key >> 32);
+    }
+
+    // Stores a copy of the solution if it beats the current best.
+    auto offer(Solution &solution, int restart_index) -> void {
+        auto key = get_key(solution.get_filled_bin_count(), restart_index);
+
+        if (key >= this->best_key.load(std::memory_order_acquire)) {
+            return;
+        }
+
+        auto lock = std::unique_lock<std::mutex>{this->mutex};
+
+        if (key >= this->best_key.load(std::memory_order_relaxed)) {
+            return;
+        }
+
+        auto improved = !this->solution || solution.get_filled_bin_count() < this->solution->get_filled_bin_count();
+
+        this->solution = solution;
+        this->best_key.store(key, std::memory_order_release);
+
+        if (improved && this->new_best_cb) {
+            this->new_best_cb(*this->solution);
+        }
+    }
+
+    auto take_solution() -> Solution {
+        return std::move(*this->solution);
+    }
+};
+
+class HillClimbingSolutionFactory : public TrajectorySolutionFactory {
+private:
+    Random rgen;
+
+    // Steepest descent over the whole neighborhood; `should_stop` is checked between steps.
+    template <typename ShouldStop>
+    auto climb(Solution &solution, Random &rgen, ShouldStop should_stop) -> void {
+        auto engine = make_trajectory_engine(
+            this->neighborhood,
+            BestNeighborStep{},
+            ImprovingAcceptance{},
+            this->lower_bound);
+
+        engine.run(
+            solution,
+            solution,
+            rgen,
+            std::numeric_limits<int>::max(),
+            should_stop,
+            [](Solution &) {});
+    }
+
+public:
+    HillClimbingSolutionFactory(InstancePtr instance, Random rgen)
+        : TrajectorySolutionFactory(std::move(instance)),
+          rgen(rgen) {
+    }
+
+    auto generate_random_hillclimbing_solution() -> Solution {
+        auto best_solution = Solution{this->instance, this->start_genome};
+        this->report_new_best(best_solution);
+
+        auto engine = make_trajectory_engine(
+            this->neighborhood,
+            RandomMoveStep{},
+            NonWorseningAcceptance{},
+            this->lower_bound);
+
+        engine.run(
+            best_solution,
+            best_solution,
+            this->rgen,
+            std::numeric_limits<int>::max(),
+            [&]() { return this->deadline.is_expired(); },
+            [&](Solution &solution) { this->report_new_best(solution); });
+
+        return best_solution;
+    }
+
+    auto generate_deterministic_hillclimbing_solution() -> Solution {
+        auto best_solution = Solution{this->instance, this->start_genome};
+        this->report_new_best(best_solution);
+
+        auto engine = make_trajectory_engine(
+            this->neighborhood,
+            BestNeighborStep{},
+            ImprovingAcceptance{},
+            this->lower_bound);
+
+        // Every step scans the whole neighborhood, so the clock is read each time.
+        engine.run(
+            best_solution,
+            best_solution,
+            this->rgen,
+            std::numeric_limits<int>::max(),
+            [&]() { return this->deadline.is_expired_now(); },
+            [&](Solution &solution) { this->report_new_best(solution); });
+
+        return best_solution;
+    }
+
+    // Deterministic climbs from the start and from shuffles, run in parallel until `restart_count`
+    // climbs have finished or the deadline has passed; restart count 0 means no limit.
+    // Restart `i` draws from its own generator and is cut short only by a lower
+    // restart that reached the lower bound, never by a higher one, so with no time
+    // limit a seed reproduces the result regardless of thread count and timing.
+    auto generate_multistart_hillclimbing_solution(int restart_count, int thread_count) -> Solution {
+        auto pool = WorkStealingPool{thread_count};
+        auto best_solution_slot = BestSolutionSlot{this->new_best_cb};
+
+        auto restart_limit = restart_count > 0 ? restart_count : std::numeric_limits<int>::max();
+        auto restart_seed = this->rgen();
+        auto next_restart_index = std::atomic<int>{0};
+        auto first_optimal_restart_index = std::atomic<int>{std::numeric_limits<int>::max()};
+        auto evaluation_counter = get_bound_evaluation_counter();
+
+        // Every finished restart queues the next one, so unlimited restarts need no
+        // upfront task list, while the initial batch gives idle workers work to steal.
+        std::function<void()> run_restart = [&]() {
+            auto evaluation_scope = EvaluationCountScope{evaluation_counter};
+            auto restart_index = next_restart_index.fetch_add(1, std::memory_order_relaxed);
+            auto deadline = this->deadline;
+
+            auto is_finished = [&]() {
+                return first_optimal_restart_index.load(std::memory_order_relaxed) < restart_index ||
+                       deadline.is_expired_now();
+            };
+
+            // The first restart always runs, so there is a solution to return.
+            if (restart_index >= restart_limit || (restart_index > 0 && is_finished())) {
+                return;
+            }
+
+            auto restart_rgen = Random{restart_seed + restart_index};
+            auto items = range(this->instance->get_item_count());
+            std::shuffle(items.begin(), items.end(), restart_rgen);
+
+            // The first restart climbs from the selected start instead.
+            auto solution = restart_index == 0
+                                ? Solution{this->instance, this->start_genome}
+                                : Solution{this->instance, Genome{items}};
+            this->climb(solution, restart_rgen, is_finished);
+
+            if (solution.get_filled_bin_count() <= this->lower_bound) {
+                auto index = first_optimal_restart_index.load(std::memory_order_relaxed);
+                while (restart_index < index &&
+                       !first_optimal_restart_index.compare_exchange_weak(index, restart_index, std::memory_order_relaxed)) {
+                }
+            }
+
+            best_solution_slot.offer(solution, restart_index);
+
+            pool.submit(run_restart);
+        };
+
+        auto initial_task_count = std::min(restart_limit, 4 * pool.get_thread_count());
+        for (auto i = 0; i < initial_task_count; i++) {
+            pool.submit(run_restart);
+        }
+
+        pool.wait();
+
+        return best_solution_slot.take_solution();
+    }
+};
+
+static auto solve_with_hill_climbing(
+    InstancePtr instance,
+    const std::vector<int> &args,
+    const Options &options,
+    const SolveBudget &budget,
+    NewBestCb new_best_cb)
+    -> SolveResult {
+    auto seed = resolve_seed(std::stoull(options.at("seed")));
+    auto solution_factory = HillClimbingSolutionFactory{std::move(instance), Random{seed}};
+
+    auto statistics = RunStatistics{solution_factory.get_lower_bound()};
+    auto evaluation_scope = EvaluationCountScope{statistics.get_evaluation_counter()};
+    solution_factory.set_new_best_cb(make_new_best_cb(statistics, std::move(new_best_cb)));
+    solution_factory.set_deadline(Deadline{budget.time_limit_ms, budget.cancelled});
+    solution_factory.set_start(options.at("start"));
+    solution_factory.set_neighborhood(Neighborhood{
+        parse_neighborhood_type(options.at("neighborhood")),
+        get_int_option(options, "candidate-bins")});
+
+    auto solutions = std::vector<LabelledSolution>{};
+
+    if (args[0] > 0 || budget.time_limit_ms > 0) {
+        solutions.push_back({
+            "Multi-start hill climbing solution",
+            solution_factory.generate_multistart_hillclimbing_solution(args[0], args[1]),
+        });
+    } else {
+        solutions.push_back({
+            "Random hill climbing solution",
+            solution_factory.generate_random_hillclimbing_solution(),
+        });
+        solutions.push_back({
+            "Deterministic hill climbing solution",
+            solution_factory.generate_deterministic_hillclimbing_solution(),
+        });
+    }
+
+    statistics.finish();
+
+    return SolveResult{std::move(solutions), statistics, seed};
+}
+
+auto get_hill_climbing_spec() -> AlgorithmSpec {
+    return AlgorithmSpec{
+        {
+            {
+                "Restart count",
+                "Climbs from shuffled starts; 0 -> a single random and deterministic climb,"
+                " unless a time limit is set",
+                {},
+                0,
+            },
+            {
+                "Thread count",
+                "Thread count not greater than 0 means one thread per hardware thread",
+                {},
+                0,
+            },
+        },
+        get_trajectory_solver_options(),
+        true,
+        solve_with_hill_climbing,
+    };
+}
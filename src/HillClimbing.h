@@ -0,0 +1,9 @@
+#include "Solver.h"
+
+#ifndef HILL_CLIMBING_H
+#define HILL_CLIMBING_H
+
+// Spec of the "hill-climbing" algorithm of solve().
+auto get_hill_climbing_spec() -> AlgorithmSpec;
+
+#endif // HILL_CLIMBING_H
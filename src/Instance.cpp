@@ -0,0 +1,203 @@
+#include "Instance.h"
+#include "GarbageBag.h"
+#include <cctype>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+static auto weights_of(const std::vector<GarbageBag> &garbage_bags) -> std::vector<int> {
+    auto weights = std::vector<int>{};
+    weights.reserve(garbage_bags.size());
+
+    for (auto bag : garbage_bags) {
+        weights.push_back(bag.get_weight());
+    }
+
+    return weights;
+}
+
+Instance::Instance(
+    int bin_weight_limit,
+    const std::vector<GarbageBag> &garbage_bags)
+    : Instance(bin_weight_limit, weights_of(garbage_bags)) {
+}
+
+Instance::Instance(
+    int bin_weight_limit,
+    std::vector<int> weights)
+    : bin_weight_limit(bin_weight_limit) {
+    auto owned_weights = std::make_shared<const std::vector<int>>(std::move(weights));
+
+    this->weights = owned_weights->data();
+    this->item_count = owned_weights->size();
+    this->storage = std::move(owned_weights);
+}
+
+Instance::Instance(
+    int bin_weight_limit,
+    const int *weights,
+    int item_count,
+    std::shared_ptr<const void> storage)
+    : storage(std::move(storage)),
+      weights(weights),
+      item_count(item_count),
+      bin_weight_limit(bin_weight_limit) {
+}
+
+// Read-only mapping of a whole file, unmapped when the last owner goes away.
+struct MappedFile {
+    void *data;
+    std::size_t size;
+
+    ~MappedFile() {
+        if (this->data != MAP_FAILED) {
+            munmap(this->data, this->size);
+        }
+    }
+};
+
+static auto map_file(const std::string &path) -> std::shared_ptr<MappedFile> {
+    auto fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error{"Cannot open instance file: " + path};
+    }
+
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) < 0) {
+        close(fd);
+        throw std::runtime_error{"Cannot stat instance file: " + path};
+    }
+
+    auto mapped_file = std::make_shared<MappedFile>(MappedFile{MAP_FAILED, (std::size_t)file_stat.st_size});
+
+    if (mapped_file->size) {
+        mapped_file->data = mmap(nullptr, mapped_file->size, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+
+    close(fd);
+
+    if (mapped_file->size && mapped_file->data == MAP_FAILED) {
+        throw std::runtime_error{"Cannot map instance file: " + path};
+    }
+
+    return mapped_file;
+}
+
+static auto is_binary_instance(const MappedFile &mapped_file) -> bool {
+    return mapped_file.size >= sizeof(BinaryInstanceHeader) &&
+           !std::memcmp(mapped_file.data, BINARY_INSTANCE_MAGIC, sizeof(BINARY_INSTANCE_MAGIC));
+}
+
+static auto load_binary_instance(
+    const std::string &path,
+    std::shared_ptr<MappedFile> mapped_file,
+    int bin_weight_limit)
+    -> InstancePtr {
+    auto header = BinaryInstanceHeader{};
+    std::memcpy(&header, mapped_file->data, sizeof(header));
+
+    auto weights_size = mapped_file->size - sizeof(header);
+
+    if (header.version != BINARY_INSTANCE_VERSION ||
+        header.item_count != weights_size / sizeof(std::int32_t)) {
+        throw std::runtime_error{"Malformed binary instance file: " + path};
+    }
+
+    auto weights = (const int *)((const char *)mapped_file->data + sizeof(header));
+
+    if (bin_weight_limit <= 0 && header.bin_weight_limit <= 0) {
+        throw std::runtime_error{"Bin weight limit of binary instance file is not positive: " + path};
+    }
+
+    return std::make_shared<const Instance>(
+        bin_weight_limit > 0 ? bin_weight_limit : header.bin_weight_limit,
+        weights,
+        (int)header.item_count,
+        std::move(mapped_file));
+}
+
+static auto load_text_instance(
+    const std::string &path,
+    const MappedFile &mapped_file,
+    int bin_weight_limit,
+    std::shared_ptr<std::vector<int>> weight_buffer)
+    -> InstancePtr {
+    auto &weights = *weight_buffer;
+    weights.clear();
+
+    auto text = (const char *)mapped_file.data;
+    auto text_end = text + mapped_file.size;
+
+    while (text < text_end) {
+        if (std::isspace((unsigned char)*text)) {
+            text++;
+            continue;
+        }
+
+        auto weight = 0;
+        auto [next, error] = std::from_chars(text, text_end, weight);
+
+        if (error != std::errc{}) {
+            throw std::runtime_error{"Malformed text instance file: " + path};
+        }
+
+        if (weight <= 0) {
+            throw std::runtime_error{"Weight not greater than 0 in text instance file: " + path};
+        }
+
+        weights.push_back(weight);
+        text = next;
+    }
+
+    return std::make_shared<const Instance>(
+        bin_weight_limit > 0 ? bin_weight_limit : DEFAULT_BIN_WEIGHT_LIMIT,
+        weights.data(),
+        (int)weights.size(),
+        std::move(weight_buffer));
+}
+
+auto load_instance(
+    const std::string &path,
+    int bin_weight_limit,
+    std::shared_ptr<std::vector<int>> weight_buffer)
+    -> InstancePtr {
+    auto mapped_file = map_file(path);
+
+    if (is_binary_instance(*mapped_file)) {
+        return load_binary_instance(path, std::move(mapped_file), bin_weight_limit);
+    }
+
+    return load_text_instance(path, *mapped_file, bin_weight_limit, std::move(weight_buffer));
+}
+
+auto load_instance(const std::string &path, int bin_weight_limit) -> InstancePtr {
+    return load_instance(path, bin_weight_limit, std::make_shared<std::vector<int>>());
+}
+
+auto save_binary_instance(const std::string &path, const Instance &instance) -> void {
+    auto file = std::ofstream{path, std::ios_base::out | std::ios_base::binary};
+    if (!file) {
+        throw std::runtime_error{"Cannot create instance file: " + path};
+    }
+
+    auto header = BinaryInstanceHeader{};
+    std::memcpy(header.magic, BINARY_INSTANCE_MAGIC, sizeof(header.magic));
+    header.version = BINARY_INSTANCE_VERSION;
+    header.bin_weight_limit = instance.get_bin_weight_limit();
+    header.reserved = 0;
+    header.item_count = instance.get_item_count();
+
+    file.write((const char *)&header, sizeof(header));
+    file.write(
+        (const char *)instance.get_weights(),
+        sizeof(std::int32_t) * instance.get_item_count());
+}
@@ -0,0 +1,84 @@
+#include "GarbageBag.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#ifndef INSTANCE_H
+#define INSTANCE_H
+
+const auto DEFAULT_BIN_WEIGHT_LIMIT = 100;
+
+// Header of the binary instance format, followed by `item_count` int32 weights.
+struct BinaryInstanceHeader {
+    char magic[4];
+    std::uint32_t version;
+    std::int32_t bin_weight_limit;
+    std::uint32_t reserved;
+    std::uint64_t item_count;
+};
+
+const char BINARY_INSTANCE_MAGIC[4] = {'M', 'H', 'E', 'I'};
+const auto BINARY_INSTANCE_VERSION = 1u;
+
+// Immutable problem data shared by every solution: bag weights and the bin weight limit.
+// Weights either live in an owned vector or in a read-only memory-mapped binary file.
+class Instance {
+private:
+    std::shared_ptr<const void> storage;
+    const int *weights;
+    int item_count;
+    int bin_weight_limit;
+
+public:
+    Instance(
+        int bin_weight_limit,
+        const std::vector<GarbageBag> &garbage_bags);
+
+    Instance(
+        int bin_weight_limit,
+        std::vector<int> weights);
+
+    // Weights borrowed from `storage`, which is kept alive as long as the instance.
+    Instance(
+        int bin_weight_limit,
+        const int *weights,
+        int item_count,
+        std::shared_ptr<const void> storage);
+
+    inline auto get_weights() const -> const int * {
+        return this->weights;
+    }
+
+    inline auto get_weight(int item) const -> int {
+        return this->weights[item];
+    }
+
+    inline auto get_item_count() const -> int {
+        return this->item_count;
+    }
+
+    inline auto get_bin_weight_limit() const -> int {
+        return this->bin_weight_limit;
+    }
+};
+
+using InstancePtr = std::shared_ptr<const Instance>;
+
+// Loads a text (whitespace separated weights) or binary instance, detected by
+// its magic bytes. Bin weight limit not greater than 0 means the one stored
+// in a binary instance, or DEFAULT_BIN_WEIGHT_LIMIT for text instances.
+auto load_instance(const std::string &path, int bin_weight_limit = 0) -> InstancePtr;
+
+// Same, but a text instance is parsed into `weight_buffer`, which is cleared
+// first and kept alive by the instance, so its capacity can be reused once
+// the instance is gone. Binary instances are mapped and leave it untouched.
+auto load_instance(
+    const std::string &path,
+    int bin_weight_limit,
+    std::shared_ptr<std::vector<int>> weight_buffer)
+    -> InstancePtr;
+
+auto save_binary_instance(const std::string &path, const Instance &instance) -> void;
+
+#endif // INSTANCE_H
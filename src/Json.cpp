@@ -0,0 +1,297 @@
+#include "Json.h"
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Nesting deeper than this is rejected instead of overflowing the stack.
+const auto MAX_JSON_DEPTH = 64;
+
+auto JsonValue::find(const std::string &key) const -> const JsonValue * {
+    for (auto &[member_key, member_value] : this->object) {
+        if (member_key == key) {
+            return &member_value;
+        }
+    }
+
+    return nullptr;
+}
+
+auto JsonValue::get_int() const -> int {
+    if (this->type != JsonType::NUMBER || this->number != std::floor(this->number) ||
+        std::abs(this->number) > 2147483647.0) {
+        throw std::invalid_argument{"Expected an integer"};
+    }
+
+    return (int)this->number;
+}
+
+auto JsonValue::get_string() const -> const std::string & {
+    if (this->type != JsonType::STRING) {
+        throw std::invalid_argument{"Expected a string"};
+    }
+
+    return this->string;
+}
+
+auto JsonValue::to_option_string() const -> std::string {
+    switch (this->type) {
+    case JsonType::BOOLEAN:
+        return this->boolean ? "1" : "0";
+    case JsonType::NUMBER:
+        return this->number == std::floor(this->number) && std::abs(this->number) < 1e18
+                   ? std::to_string((long long)this->number)
+                   : std::to_string(this->number);
+    case JsonType::STRING:
+        return this->string;
+    default:
+        throw std::invalid_argument{"Expected a number, boolean or string"};
+    }
+}
+
+class JsonParser {
+private:
+    const std::string &text;
+    std::size_t position;
+
+    auto fail(const std::string &message) -> void {
+        throw std::invalid_argument{"Malformed JSON at " + std::to_string(this->position) + ": " + message};
+    }
+
+    auto skip_whitespace() -> void {
+        while (this->position < this->text.size() && std::isspace((unsigned char)this->text[this->position])) {
+            this->position++;
+        }
+    }
+
+    auto peek() -> char {
+        this->skip_whitespace();
+        return this->position < this->text.size() ? this->text[this->position] : '\0';
+    }
+
+    auto expect(char c) -> void {
+        if (this->peek() != c) {
+            this->fail(std::string{"expected '"} + c + "'");
+        }
+
+        this->position++;
+    }
+
+    auto consume_literal(const std::string &literal) -> void {
+        if (this->text.compare(this->position, literal.size(), literal) != 0) {
+            this->fail("unknown literal");
+        }
+
+        this->position += literal.size();
+    }
+
+    auto parse_string() -> std::string {
+        this->expect('"');
+        auto str = std::string{};
+
+        while (this->position < this->text.size()) {
+            auto c = this->text[this->position++];
+
+            if (c == '"') {
+                return str;
+            }
+
+            if (c != '\\') {
+                str += c;
+                continue;
+            }
+
+            if (this->position >= this->text.size()) {
+                break;
+            }
+
+            auto escaped = this->text[this->position++];
+            switch (escaped) {
+            case 'b':
+                str += '\b';
+                break;
+            case 'f':
+                str += '\f';
+                break;
+            case 'n':
+                str += '\n';
+                break;
+            case 'r':
+                str += '\r';
+                break;
+            case 't':
+                str += '\t';
+                break;
+            case 'u': {
+                if (this->position + 4 > this->text.size()) {
+                    this->fail("truncated escape");
+                }
+
+                auto code_point = std::strtol(this->text.substr(this->position, 4).c_str(), nullptr, 16);
+                this->position += 4;
+
+                // Encoded as UTF-8; surrogate pairs are not combined.
+                if (code_point < 0x80) {
+                    str += (char)code_point;
+                } else if (code_point < 0x800) {
+                    str += (char)(0xC0 | code_point >> 6);
+                    str += (char)(0x80 | (code_point & 0x3F));
+                } else {
+                    str += (char)(0xE0 | code_point >> 12);
+                    str += (char)(0x80 | (code_point >> 6 & 0x3F));
+                    str += (char)(0x80 | (code_point & 0x3F));
+                }
+                break;
+            }
+            default:
+                str += escaped;
+            }
+        }
+
+        this->fail("unterminated string");
+        return str;
+    }
+
+    auto parse_number() -> double {
+        auto start = this->text.c_str() + this->position;
+        char *end = nullptr;
+        auto number = std::strtod(start, &end);
+
+        if (end == start) {
+            this->fail("expected a value");
+        }
+
+        this->position += end - start;
+        return number;
+    }
+
+public:
+    explicit JsonParser(const std::string &text)
+        : text(text),
+          position(0) {
+    }
+
+    auto parse_value(int depth = 0) -> JsonValue {
+        if (depth > MAX_JSON_DEPTH) {
+            this->fail("nested too deeply");
+        }
+
+        auto value = JsonValue{};
+
+        switch (this->peek()) {
+        case '{':
+            value.type = JsonType::OBJECT;
+            this->position++;
+
+            if (this->peek() == '}') {
+                this->position++;
+                return value;
+            }
+
+            while (true) {
+                auto key = this->parse_string();
+                this->expect(':');
+                value.object.emplace_back(std::move(key), this->parse_value(depth + 1));
+
+                if (this->peek() != ',') {
+                    break;
+                }
+
+                this->position++;
+            }
+
+            this->expect('}');
+            return value;
+        case '[':
+            value.type = JsonType::ARRAY;
+            this->position++;
+
+            if (this->peek() == ']') {
+                this->position++;
+                return value;
+            }
+
+            while (true) {
+                value.array.push_back(this->parse_value(depth + 1));
+
+                if (this->peek() != ',') {
+                    break;
+                }
+
+                this->position++;
+            }
+
+            this->expect(']');
+            return value;
+        case '"':
+            value.type = JsonType::STRING;
+            value.string = this->parse_string();
+            return value;
+        case 't':
+            value.type = JsonType::BOOLEAN;
+            value.boolean = true;
+            this->consume_literal("true");
+            return value;
+        case 'f':
+            value.type = JsonType::BOOLEAN;
+            this->consume_literal("false");
+            return value;
+        case 'n':
+            this->consume_literal("null");
+            return value;
+        default:
+            value.type = JsonType::NUMBER;
+            value.number = this->parse_number();
+            return value;
+        }
+    }
+
+    auto parse_document() -> JsonValue {
+        auto value = this->parse_value();
+
+        if (this->peek() != '\0') {
+            this->fail("trailing characters");
+        }
+
+        return value;
+    }
+};
+
+auto parse_json(const std::string &text) -> JsonValue {
+    return JsonParser{text}.parse_document();
+}
+
+auto quote_json(const std::string &str) -> std::string {
+    auto quoted = std::string{"\""};
+
+    for (auto c : str) {
+        switch (c) {
+        case '"':
+            quoted += "\\\"";
+            break;
+        case '\\':
+            quoted += "\\\\";
+            break;
+        case '\n':
+            quoted += "\\n";
+            break;
+        case '\t':
+            quoted += "\\t";
+            break;
+        default:
+            if ((unsigned char)c < 0x20) {
+                char escaped[8];
+                std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+                quoted += escaped;
+            } else {
+                quoted += c;
+            }
+        }
+    }
+
+    return quoted + "\"";
+}
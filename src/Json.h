@@ -0,0 +1,45 @@
+#include <string>
+#include <utility>
+#include <vector>
+
+#ifndef JSON_H
+#define JSON_H
+
+enum class JsonType {
+    NUL,
+    BOOLEAN,
+    NUMBER,
+    STRING,
+    ARRAY,
+    OBJECT,
+};
+
+// Parsed JSON document; just enough for line protocols, so object keys keep
+// their order and lookups are linear.
+struct JsonValue {
+    JsonType type = JsonType::NUL;
+    bool boolean = false;
+    double number = 0;
+    std::string string;
+    std::vector<JsonValue> array;
+    std::vector<std::pair<std::string, JsonValue>> object;
+
+    // Null if the value is not an object or has no such member.
+    auto find(const std::string &key) const -> const JsonValue *;
+
+    // The getters throw std::invalid_argument on a value of another type.
+    auto get_int() const -> int;
+
+    auto get_string() const -> const std::string &;
+
+    // Numbers and booleans as they would be written in JSON, strings as they are.
+    auto to_option_string() const -> std::string;
+};
+
+// Throws std::invalid_argument on malformed input or trailing characters.
+auto parse_json(const std::string &text) -> JsonValue;
+
+// JSON string literal of `str`, quotes included.
+auto quote_json(const std::string &str) -> std::string;
+
+#endif // JSON_H
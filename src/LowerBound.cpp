@@ -0,0 +1,69 @@
+#include "LowerBound.h"
+#include "Instance.h"
+#include <algorithm>
+#include <vector>
+
+static auto divide_rounding_up(long long dividend, long long divisor) -> long long {
+    return (dividend + divisor - 1) / divisor;
+}
+
+auto calculate_l1_lower_bound(const Instance &instance) -> int {
+    auto weights = instance.get_weights();
+    auto weight_sum = 0LL;
+
+    for (auto i = 0; i < instance.get_item_count(); i++) {
+        weight_sum += weights[i];
+    }
+
+    return divide_rounding_up(weight_sum, instance.get_bin_weight_limit());
+}
+
+auto calculate_l2_lower_bound(const Instance &instance) -> int {
+    auto limit = (long long)instance.get_bin_weight_limit();
+
+    auto weights = std::vector<int>{
+        instance.get_weights(),
+        instance.get_weights() + instance.get_item_count()};
+    std::sort(weights.begin(), weights.end());
+
+    // weight_sums[i]: sum of the i lightest weights.
+    auto weight_sums = std::vector<long long>{0};
+    for (auto weight : weights) {
+        weight_sums.push_back(weight_sums.back() + weight);
+    }
+
+    // Index of the first weight above `weight`.
+    auto count_up_to = [&](long long weight) -> int {
+        return std::upper_bound(weights.begin(), weights.end(), weight) - weights.begin();
+    };
+
+    auto item_count = (int)weights.size();
+    auto half_limit_end = count_up_to(limit / 2);
+    auto best_bound = 0LL;
+
+    // L(K) only changes at bag weights, so K = 0 and every weight up to half the limit cover all cases.
+    for (auto k_index = -1; k_index < half_limit_end; k_index++) {
+        auto k = k_index < 0 ? 0LL : (long long)weights[k_index];
+
+        if (k_index > 0 && k == weights[k_index - 1]) {
+            continue;
+        }
+
+        auto big_begin = count_up_to(limit - k);
+        auto small_begin = k_index < 0 ? 0 : k_index;
+
+        auto big_count = item_count - big_begin;
+        auto large_count = big_begin - half_limit_end;
+        auto large_free_space = large_count * limit - (weight_sums[big_begin] - weight_sums[half_limit_end]);
+        auto small_weight = weight_sums[half_limit_end] - weight_sums[small_begin];
+
+        auto bound = big_count + large_count + std::max(0LL, divide_rounding_up(small_weight - large_free_space, limit));
+        best_bound = std::max(best_bound, bound);
+    }
+
+    return best_bound;
+}
+
+auto calculate_lower_bound(const Instance &instance) -> int {
+    return std::max(calculate_l1_lower_bound(instance), calculate_l2_lower_bound(instance));
+}
@@ -0,0 +1,17 @@
+#include "Instance.h"
+
+#ifndef LOWER_BOUND_H
+#define LOWER_BOUND_H
+
+// ceil(total weight / bin weight limit).
+auto calculate_l1_lower_bound(const Instance &instance) -> int;
+
+// Martello-Toth L2: for every K up to half the limit, bags heavier than limit - K
+// need a bin each, bags heavier than half the limit need a bin each too, and bags
+// of at least K that do not fit the space left by the latter need extra bins.
+auto calculate_l2_lower_bound(const Instance &instance) -> int;
+
+// Best of the bounds above; no solution can use fewer bins.
+auto calculate_lower_bound(const Instance &instance) -> int;
+
+#endif // LOWER_BOUND_H
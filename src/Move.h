@@ -0,0 +1,87 @@
+#ifndef MOVE_H
+#define MOVE_H
+
+enum class MoveType {
+    SWAP,
+    BLOCK,
+};
+
+// Swap of the bags at index1 and index2, or relocation of the `length` bags
+// starting at index1 so that they start at index2 afterwards; relocating a
+// single bag is an insertion.
+struct Move {
+    int index1;
+    int index2;
+    MoveType type = MoveType::SWAP;
+    int length = 1;
+};
+
+// Move undoing the given one.
+inline auto get_inverse_move(const Move &move) -> Move {
+    if (move.type == MoveType::BLOCK) {
+        return Move{move.index2, move.index1, MoveType::BLOCK, move.length};
+    }
+
+    return move;
+}
+
+// Range of positions a block relocation rotates: the bag at `middle` moves to `first`.
+struct Rotation {
+    int first;
+    int middle;
+    int last;
+};
+
+inline auto get_block_rotation(int index1, int index2, int length) -> Rotation {
+    if (index2 < index1) {
+        return Rotation{index2, index1, index1 + length};
+    }
+
+    return Rotation{index1, index1 + length, index2 + length};
+}
+
+// Lazily enumerates swaps of every bag with its (cyclic) successor.
+class AdjacentSwapNeighborhood {
+private:
+    int bag_count;
+
+public:
+    class Iterator {
+    private:
+        int index;
+        int bag_count;
+
+    public:
+        inline Iterator(int index, int bag_count)
+            : index(index),
+              bag_count(bag_count) {
+        }
+
+        inline auto operator*() const -> Move {
+            return Move{this->index, (this->index + 1) % this->bag_count};
+        }
+
+        inline auto operator++() -> Iterator & {
+            this->index++;
+            return *this;
+        }
+
+        inline auto operator!=(const Iterator &other) const -> bool {
+            return this->index != other.index;
+        }
+    };
+
+    inline explicit AdjacentSwapNeighborhood(int bag_count)
+        : bag_count(bag_count) {
+    }
+
+    inline auto begin() const -> Iterator {
+        return Iterator{0, this->bag_count};
+    }
+
+    inline auto end() const -> Iterator {
+        return Iterator{this->bag_count, this->bag_count};
+    }
+};
+
+#endif // MOVE_H
@@ -0,0 +1,96 @@
+#include "Neighborhood.h"
+#include "Move.h"
+#include "Random.h"
+#include "Solution.h"
+#include "utils.h"
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+auto parse_neighborhood_type(const std::string &name) -> NeighborhoodType {
+    if (name == "adjacent") {
+        return NeighborhoodType::ADJACENT;
+    }
+
+    if (name == "swap") {
+        return NeighborhoodType::SWAP;
+    }
+
+    if (name == "insert") {
+        return NeighborhoodType::INSERT;
+    }
+
+    if (name == "block") {
+        return NeighborhoodType::BLOCK;
+    }
+
+    throw std::invalid_argument{"Unknown neighborhood: " + name};
+}
+
+Neighborhood::Neighborhood(NeighborhoodType type, int candidate_bin_count)
+    : type(type),
+      candidate_bin_count(candidate_bin_count) {
+}
+
+auto Neighborhood::get_type() -> NeighborhoodType {
+    return this->type;
+}
+
+auto Neighborhood::get_candidate_bins(Solution &solution) -> std::vector<int> {
+    auto &bin_loads = solution.get_bin_loads();
+    auto bins = range(bin_loads.size());
+
+    if (this->candidate_bin_count > 0 && this->candidate_bin_count < (int)bins.size()) {
+        std::nth_element(
+            bins.begin(),
+            bins.begin() + this->candidate_bin_count,
+            bins.end(),
+            [&](int a, int b) {
+                return bin_loads[a] < bin_loads[b];
+            });
+
+        bins.resize(this->candidate_bin_count);
+        std::sort(bins.begin(), bins.end());
+    }
+
+    return bins;
+}
+
+auto Neighborhood::generate_random_move(Solution &solution, Random &rgen) -> Move {
+    auto bag_count = solution.get_genome().get_size();
+
+    if (this->type == NeighborhoodType::ADJACENT || bag_count < 2) {
+        return solution.generate_random_move(rgen);
+    }
+
+    profile_count(ProfileCounter::NEIGHBORS_GENERATED);
+
+    if (this->type == NeighborhoodType::SWAP) {
+        return Move{rgen.next_index(bag_count), rgen.next_index(bag_count)};
+    }
+
+    if (this->type == NeighborhoodType::INSERT) {
+        return Move{rgen.next_index(bag_count), rgen.next_index(bag_count), MoveType::BLOCK, 1};
+    }
+
+    auto &bin_starts = solution.get_bin_starts();
+    auto bin_count = (int)bin_starts.size();
+
+    auto get_bin_end = [&](int bin) {
+        return bin + 1 < bin_count ? bin_starts[bin + 1] : bag_count;
+    };
+
+    auto bin = rgen.next_index(bin_count);
+    auto target_bin = rgen.next_index(bin_count + 1);
+
+    auto index1 = bin_starts[bin];
+    auto length = get_bin_end(bin) - index1;
+    auto target = target_bin < bin_count ? bin_starts[target_bin] : bag_count;
+
+    if (target >= index1 && target <= index1 + length) {
+        return Move{index1, index1, MoveType::BLOCK, length};
+    }
+
+    return Move{index1, target < index1 ? target : target - length, MoveType::BLOCK, length};
+}
@@ -0,0 +1,122 @@
+#include "Move.h"
+#include "Profile.h"
+#include "Random.h"
+#include "Solution.h"
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#ifndef NEIGHBORHOOD_H
+#define NEIGHBORHOOD_H
+
+enum class NeighborhoodType {
+    // Swaps of every bag with its successor.
+    ADJACENT,
+    // Swaps of any two bags.
+    SWAP,
+    // A single bag moved to another position.
+    INSERT,
+    // A whole bin moved next to another bin.
+    BLOCK,
+};
+
+auto parse_neighborhood_type(const std::string &name) -> NeighborhoodType;
+
+// Moves a trajectory solver scans or samples. With a candidate bin count, moved
+// bags come from the least filled bins only, and insertions and blocks only land
+// next to those bins, so the larger neighborhoods stay affordable.
+class Neighborhood {
+private:
+    NeighborhoodType type;
+    int candidate_bin_count;
+
+public:
+    // Candidate bin count not greater than 0 means every bin.
+    explicit Neighborhood(NeighborhoodType type = NeighborhoodType::ADJACENT, int candidate_bin_count = 0);
+
+    auto get_type() -> NeighborhoodType;
+
+    // Least filled bins in bin order, or every bin without a candidate bin count.
+    auto get_candidate_bins(Solution &solution) -> std::vector<int>;
+
+    // Calls `cb(move)` for every move, without materializing the neighborhood.
+    template <typename Cb>
+    auto for_each_move(Solution &solution, Cb &&cb) -> void {
+        auto counted_cb = [&](Move move) {
+            profile_count(ProfileCounter::NEIGHBORS_GENERATED);
+            cb(move);
+        };
+
+        auto bag_count = solution.get_genome().get_size();
+
+        if (this->type == NeighborhoodType::ADJACENT) {
+            for (auto move : solution.get_neighborhood()) {
+                counted_cb(move);
+            }
+
+            return;
+        }
+
+        auto candidate_bins = this->get_candidate_bins(solution);
+        auto &bin_starts = solution.get_bin_starts();
+
+        auto get_bin_end = [&](int bin) {
+            return bin + 1 < (int)bin_starts.size() ? bin_starts[bin + 1] : bag_count;
+        };
+
+        if (this->type == NeighborhoodType::SWAP) {
+            auto is_candidate = std::vector<bool>(bag_count);
+            for (auto bin : candidate_bins) {
+                for (auto index = bin_starts[bin]; index < get_bin_end(bin); index++) {
+                    is_candidate[index] = true;
+                }
+            }
+
+            for (auto bin : candidate_bins) {
+                for (auto index1 = bin_starts[bin]; index1 < get_bin_end(bin); index1++) {
+                    for (auto index2 = 0; index2 < bag_count; index2++) {
+                        // Pairs of candidate bags are listed once.
+                        if (index2 == index1 || (index2 < index1 && is_candidate[index2])) {
+                            continue;
+                        }
+
+                        counted_cb(Move{index1, index2});
+                    }
+                }
+            }
+
+            return;
+        }
+
+        // Bin boundaries next to the candidate bins.
+        auto targets = std::vector<int>{};
+        for (auto bin : candidate_bins) {
+            targets.push_back(bin_starts[bin]);
+            targets.push_back(get_bin_end(bin));
+        }
+        targets.erase(std::unique(targets.begin(), targets.end()), targets.end());
+
+        for (auto bin : candidate_bins) {
+            auto bin_start = bin_starts[bin];
+            auto bin_end = get_bin_end(bin);
+            // A block is the whole bin, so it is only moved from its start.
+            auto last_index1 = this->type == NeighborhoodType::BLOCK ? bin_start + 1 : bin_end;
+            auto length = this->type == NeighborhoodType::BLOCK ? bin_end - bin_start : 1;
+
+            for (auto index1 = bin_start; index1 < last_index1; index1++) {
+                for (auto target : targets) {
+                    if (target >= index1 && target <= index1 + length) {
+                        continue;
+                    }
+
+                    counted_cb(Move{index1, target < index1 ? target : target - length, MoveType::BLOCK, length});
+                }
+            }
+        }
+    }
+
+    // Uniform over the whole neighborhood, ignoring candidate bins.
+    auto generate_random_move(Solution &solution, Random &rgen) -> Move;
+};
+
+#endif // NEIGHBORHOOD_H
@@ -0,0 +1,139 @@
+#include "Profile.h"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <list>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Slots keep their totals after their threads exit, so there are only as many
+// as threads ever ran at once; the free ones wait in _free_profile_slots.
+auto _profile_slots = std::list<ProfileSlot>{};
+auto _free_profile_slots = std::vector<ProfileSlot *>{};
+auto _profile_slots_mutex = std::mutex{};
+
+const auto PROFILE_COUNTER_NAMES = std::array<const char *, PROFILE_COUNTER_COUNT>{
+    "full_decodes",
+    "delta_evaluations",
+    "solution_copies",
+    "genome_allocations",
+    "neighbors_generated",
+    "tabu_hits",
+};
+
+const auto PROFILE_PHASE_NAMES = std::array<const char *, PROFILE_PHASE_COUNT>{
+    "selection_ms",
+    "crossover_ms",
+    "mutation_ms",
+    "evaluation_ms",
+};
+
+ThreadProfileSlot::ThreadProfileSlot() {
+    auto lock = std::lock_guard<std::mutex>{_profile_slots_mutex};
+
+    if (_free_profile_slots.empty()) {
+        this->slot = &_profile_slots.emplace_back();
+    } else {
+        this->slot = _free_profile_slots.back();
+        _free_profile_slots.pop_back();
+    }
+}
+
+ThreadProfileSlot::~ThreadProfileSlot() {
+    auto lock = std::lock_guard<std::mutex>{_profile_slots_mutex};
+    _free_profile_slots.push_back(this->slot);
+}
+
+auto reset_profile() -> void {
+    auto lock = std::lock_guard<std::mutex>{_profile_slots_mutex};
+
+    for (auto &slot : _profile_slots) {
+        for (auto &counter : slot.counters) {
+            counter.store(0, std::memory_order_relaxed);
+        }
+
+        for (auto &phase_ns : slot.phase_ns) {
+            phase_ns.store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+// Name and merged value of every exported field, in output order.
+static auto collect_profile_fields(std::uint64_t evaluation_count) -> std::vector<std::pair<std::string, std::string>> {
+    auto counters = std::array<std::uint64_t, PROFILE_COUNTER_COUNT>{};
+    auto phase_ns = std::array<std::uint64_t, PROFILE_PHASE_COUNT>{};
+
+    {
+        auto lock = std::lock_guard<std::mutex>{_profile_slots_mutex};
+
+        for (auto &slot : _profile_slots) {
+            for (auto i = 0; i < PROFILE_COUNTER_COUNT; i++) {
+                counters[i] += slot.counters[i].load(std::memory_order_relaxed);
+            }
+
+            for (auto i = 0; i < PROFILE_PHASE_COUNT; i++) {
+                phase_ns[i] += slot.phase_ns[i].load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    auto fields = std::vector<std::pair<std::string, std::string>>{};
+    fields.emplace_back("evaluations", std::to_string(evaluation_count));
+
+    for (auto i = 0; i < PROFILE_COUNTER_COUNT; i++) {
+        fields.emplace_back(PROFILE_COUNTER_NAMES[i], std::to_string(counters[i]));
+    }
+
+    for (auto i = 0; i < PROFILE_PHASE_COUNT; i++) {
+        fields.emplace_back(PROFILE_PHASE_NAMES[i], std::to_string(phase_ns[i] / 1e6));
+    }
+
+    return fields;
+}
+
+static auto ends_with(const std::string &str, const std::string &suffix) -> bool {
+    return str.size() >= suffix.size() &&
+           str.compare(str.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+auto write_profile(const std::string &path, const std::string &solver, std::uint64_t evaluation_count) -> void {
+    if (!PROFILE_ENABLED) {
+        std::cerr << "Profiling is disabled in this build; rebuild with `make PROFILE=1`" << std::endl;
+        return;
+    }
+
+    auto fields = collect_profile_fields(evaluation_count);
+
+    if (ends_with(path, ".json")) {
+        auto file = std::ofstream{path};
+        file << "{\"solver\": \"" << solver << "\"";
+
+        for (auto &[name, value] : fields) {
+            file << ", \"" << name << "\": " << value;
+        }
+
+        file << "}" << std::endl;
+        return;
+    }
+
+    auto is_new_file = !std::ifstream{path}.good();
+    auto file = std::ofstream{path, std::ios::app};
+
+    if (is_new_file) {
+        file << "solver";
+        for (auto &[name, _] : fields) {
+            file << "," << name;
+        }
+        file << std::endl;
+    }
+
+    file << solver;
+    for (auto &[_, value] : fields) {
+        file << "," << value;
+    }
+    file << std::endl;
+}
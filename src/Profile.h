@@ -0,0 +1,155 @@
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+#ifndef PROFILE_H
+#define PROFILE_H
+
+// Hot-path counters. They are only collected in builds with MHE_PROFILE
+// defined (`make PROFILE=1`); otherwise every hook compiles to nothing.
+enum class ProfileCounter {
+    // Next-fit decodes of a whole genome.
+    FULL_DECODES,
+    // Move evaluations and bin cache updates touching part of a genome.
+    DELTA_EVALUATIONS,
+    SOLUTION_COPIES,
+    GENOME_ALLOCATIONS,
+    NEIGHBORS_GENERATED,
+    TABU_HITS,
+    COUNT,
+};
+
+// Timed phases of the genetic algorithm.
+enum class ProfilePhase {
+    SELECTION,
+    CROSSOVER,
+    MUTATION,
+    EVALUATION,
+    COUNT,
+};
+
+const auto PROFILE_COUNTER_COUNT = (int)ProfileCounter::COUNT;
+const auto PROFILE_PHASE_COUNT = (int)ProfilePhase::COUNT;
+
+// Counters of one thread; totals are merged over every slot.
+struct ProfileSlot {
+    std::array<std::atomic<std::uint64_t>, PROFILE_COUNTER_COUNT> counters{};
+    std::array<std::atomic<std::uint64_t>, PROFILE_PHASE_COUNT> phase_ns{};
+};
+
+// Holds the ProfileSlot of one thread. The slot is handed back with its totals
+// when the thread exits, and the next new thread reuses it.
+class ThreadProfileSlot {
+private:
+    ProfileSlot *slot;
+
+public:
+    ThreadProfileSlot();
+
+    ThreadProfileSlot(const ThreadProfileSlot &) = delete;
+
+    auto operator=(const ThreadProfileSlot &) -> ThreadProfileSlot & = delete;
+
+    ~ThreadProfileSlot();
+
+    auto get_slot() -> ProfileSlot & {
+        return *this->slot;
+    }
+};
+
+inline auto get_thread_profile_slot() -> ProfileSlot & {
+    thread_local ThreadProfileSlot slot;
+    return slot.get_slot();
+}
+
+inline auto add_to_slot_counter(std::atomic<std::uint64_t> &counter, std::uint64_t value) -> void {
+    counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+#ifdef MHE_PROFILE
+
+const auto PROFILE_ENABLED = true;
+
+inline auto profile_count(ProfileCounter counter, std::uint64_t value = 1) -> void {
+    auto &slot = get_thread_profile_slot();
+    add_to_slot_counter(slot.counters[(int)counter], value);
+}
+
+// Adds the time spent in the current phase to it when switching phases and
+// when going out of scope.
+class ProfilePhaseTimer {
+private:
+    ProfilePhase phase;
+    std::chrono::steady_clock::time_point start;
+
+public:
+    explicit ProfilePhaseTimer(ProfilePhase phase)
+        : phase(phase),
+          start(std::chrono::steady_clock::now()) {
+    }
+
+    ~ProfilePhaseTimer() {
+        this->switch_phase(this->phase);
+    }
+
+    auto switch_phase(ProfilePhase phase) -> void {
+        auto &slot = get_thread_profile_slot();
+        auto now = std::chrono::steady_clock::now();
+
+        add_to_slot_counter(
+            slot.phase_ns[(int)this->phase],
+            std::chrono::duration_cast<std::chrono::nanoseconds>(now - this->start).count());
+
+        this->phase = phase;
+        this->start = now;
+    }
+};
+
+// Member counting the copies of the object it belongs to.
+struct ProfileCopyCounter {
+    ProfileCopyCounter() = default;
+
+    ProfileCopyCounter(const ProfileCopyCounter &) {
+        profile_count(ProfileCounter::SOLUTION_COPIES);
+    }
+
+    ProfileCopyCounter(ProfileCopyCounter &&) = default;
+
+    auto operator=(const ProfileCopyCounter &) -> ProfileCopyCounter & {
+        profile_count(ProfileCounter::SOLUTION_COPIES);
+        return *this;
+    }
+
+    auto operator=(ProfileCopyCounter &&) -> ProfileCopyCounter & = default;
+};
+
+#else
+
+const auto PROFILE_ENABLED = false;
+
+inline auto profile_count(ProfileCounter, std::uint64_t = 1) -> void {
+}
+
+class ProfilePhaseTimer {
+public:
+    explicit ProfilePhaseTimer(ProfilePhase) {
+    }
+
+    auto switch_phase(ProfilePhase) -> void {
+    }
+};
+
+#endif
+
+// Zeroes the totals, so the next write_profile() covers only what ran since.
+// The counters are shared by the whole process, so no run may be in progress.
+auto reset_profile() -> void;
+
+// Writes the totals of every thread since the last reset, together with the
+// run's `evaluation_count`, to `path`: a JSON object when it ends with .json,
+// otherwise a CSV row appended below a header written on the file's first use.
+auto write_profile(const std::string &path, const std::string &solver, std::uint64_t evaluation_count) -> void;
+
+#endif // PROFILE_H
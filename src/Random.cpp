@@ -0,0 +1,56 @@
+#include "Random.h"
+#include <cstdint>
+#include <random>
+
+Random::Random(std::uint64_t seed) {
+    for (auto &word : this->state) {
+        seed += 0x9e3779b97f4a7c15ULL;
+
+        auto z = seed;
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        word = z ^ (z >> 31);
+    }
+}
+
+auto Random::jump() -> void {
+    static const std::uint64_t JUMP[] = {
+        0x180ec6d33cfd0abaULL,
+        0xd5a61266f0c9392cULL,
+        0xa9582618e03fc9aaULL,
+        0x39abdc4529b1661cULL,
+    };
+
+    std::uint64_t jumped_state[4] = {0, 0, 0, 0};
+
+    for (auto jump_word : JUMP) {
+        for (auto bit = 0; bit < 64; bit++) {
+            if (jump_word & (1ULL << bit)) {
+                for (auto i = 0; i < 4; i++) {
+                    jumped_state[i] ^= this->state[i];
+                }
+            }
+
+            (*this)();
+        }
+    }
+
+    for (auto i = 0; i < 4; i++) {
+        this->state[i] = jumped_state[i];
+    }
+}
+
+auto Random::split() -> Random {
+    auto stream = *this;
+    this->jump();
+    return stream;
+}
+
+auto resolve_seed(std::uint64_t seed) -> std::uint64_t {
+    if (seed) {
+        return seed;
+    }
+
+    auto rd = std::random_device{};
+    return (std::uint64_t)rd() << 32 | rd();
+}
@@ -0,0 +1,66 @@
+#include <cstdint>
+
+#ifndef RANDOM_H
+#define RANDOM_H
+
+// xoshiro256** generator. Satisfies UniformRandomBitGenerator, so it also
+// works with <random> distributions and std::shuffle.
+class Random {
+private:
+    std::uint64_t state[4];
+
+    static inline auto rotate_left(std::uint64_t x, int k) -> std::uint64_t {
+        return (x << k) | (x >> (64 - k));
+    }
+
+public:
+    using result_type = std::uint64_t;
+
+    // The seed is expanded with splitmix64, so nearby seeds give unrelated streams.
+    explicit Random(std::uint64_t seed);
+
+    static constexpr auto min() -> result_type {
+        return 0;
+    }
+
+    static constexpr auto max() -> result_type {
+        return UINT64_MAX;
+    }
+
+    inline auto operator()() -> result_type {
+        auto result = rotate_left(this->state[1] * 5, 7) * 9;
+        auto t = this->state[1] << 17;
+
+        this->state[2] ^= this->state[0];
+        this->state[3] ^= this->state[1];
+        this->state[1] ^= this->state[2];
+        this->state[0] ^= this->state[3];
+        this->state[2] ^= t;
+        this->state[3] = rotate_left(this->state[3], 45);
+
+        return result;
+    }
+
+    // Uniform integer in [0, bound) by multiply-shift; the bias is negligible
+    // for bounds far below 2^32.
+    inline auto next_index(int bound) -> int {
+        return (int)(((*this)() >> 32) * (std::uint32_t)bound >> 32);
+    }
+
+    // Uniform double in [0, 1).
+    inline auto next_double() -> double {
+        return ((*this)() >> 11) * 0x1.0p-53;
+    }
+
+    // Advances the generator by 2^128 draws.
+    auto jump() -> void;
+
+    // Generator for an independent stream: a copy of this one, which then jumps
+    // ahead, so up to 2^128 streams never overlap.
+    auto split() -> Random;
+};
+
+// Seed 0 means a seed drawn from std::random_device.
+auto resolve_seed(std::uint64_t seed) -> std::uint64_t;
+
+#endif // RANDOM_H
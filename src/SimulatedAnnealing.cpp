@@ -0,0 +1,252 @@
+#include "SimulatedAnnealing.h"
+#include "Barrier.h"
+#include "Deadline.h"
+#include "Instance.h"
+#include "Neighborhood.h"
+#include "Profile.h"
+#include "Random.h"
+#include "Solution.h"
+#include "SolutionFactory.h"
+#include "Statistics.h"
+#include "TrajectoryEngine.h"
+#include "utils.h"
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <thread>
+#include <variant>
+#include <vector>
+
+// Temperature ladder of replica exchange, geometric between these bounds.
+const auto MIN_REPLICA_TEMPERATURE = 0.05;
+const auto MAX_REPLICA_TEMPERATURE = 2.0;
+
+// Markov chain of replica exchange; its temperature is the one of its ladder position.
+struct Replica {
+    Solution solution;
+    Solution best_solution;
+    Random rgen;
+    int ladder_position;
+};
+
+class SimulatedAnnealingSolutionFactory : public TrajectorySolutionFactory {
+private:
+    Random rgen;
+
+    // Metropolis steps at a fixed temperature; the replica's best is copied only when it improves.
+    auto run_replica(Replica &replica, double temperature, int iteration_count, Deadline &deadline) -> void {
+        auto engine = make_trajectory_engine(
+            this->neighborhood,
+            RandomMoveStep{},
+            MetropolisAcceptance<ConstantCooling>{ConstantCooling{temperature}},
+            this->lower_bound);
+
+        engine.run(
+            replica.solution,
+            replica.best_solution,
+            replica.rgen,
+            iteration_count,
+            [&]() { return deadline.is_expired(); },
+            [](Solution &) {});
+    }
+
+public:
+    SimulatedAnnealingSolutionFactory(InstancePtr instance, Random rgen)
+        : TrajectorySolutionFactory(std::move(instance)),
+          rgen(rgen) {
+    }
+
+    auto generate_simulated_annealing_solution(int iteration_count, CoolingSchedule cooling_schedule) -> Solution {
+        auto current_solution = Solution{this->instance, this->start_genome};
+        auto best_solution = current_solution;
+        this->report_new_best(best_solution);
+
+        // Neighbors are evaluated as moves and only accepted ones are applied, so
+        // the solution is copied only when the best one improves. The schedule is
+        // resolved once, so the annealing loop is compiled for each of them.
+        std::visit(
+            [&](auto cooling) {
+                auto engine = make_trajectory_engine(
+                    this->neighborhood,
+                    RandomMoveStep{},
+                    MetropolisAcceptance<decltype(cooling)>{cooling},
+                    this->lower_bound);
+
+                engine.run(
+                    current_solution,
+                    best_solution,
+                    this->rgen,
+                    iteration_count,
+                    [&]() { return this->deadline.is_expired(); },
+                    [&](Solution &solution) { this->report_new_best(solution); });
+            },
+            cooling_schedule);
+
+        return best_solution;
+    }
+
+    // Replica exchange: one chain per thread, each at its own temperature. Every
+    // `exchange_interval` iterations all chains meet at a barrier, where chains on
+    // neighboring ladder positions (even or odd pairs, alternately) swap temperatures
+    // with the Metropolis probability min(1, exp((1/T_a - 1/T_b) (E_a - E_b))).
+    // Swapping temperatures rather than solutions avoids copying them.
+    auto generate_replica_exchange_solution(int chain_count, int iteration_count, int exchange_interval) -> Solution {
+        auto temperatures = std::vector<double>{};
+        for (auto i : range(chain_count)) {
+            auto ratio = chain_count > 1 ? (double)i / (chain_count - 1) : 0.0;
+            temperatures.push_back(MIN_REPLICA_TEMPERATURE * std::pow(MAX_REPLICA_TEMPERATURE / MIN_REPLICA_TEMPERATURE, ratio));
+        }
+
+        auto replicas = std::vector<Replica>{};
+        // Replica index at every ladder position.
+        auto ladder = std::vector<int>{};
+        for (auto i : range(chain_count)) {
+            auto solution = Solution{this->instance, this->start_genome};
+            replicas.push_back(Replica{solution, solution, this->rgen.split(), i});
+            ladder.push_back(i);
+        }
+
+        auto best_solution = replicas[0].best_solution;
+        this->report_new_best(best_solution);
+
+        auto exchange_round = 0;
+        // Set at a barrier only, so every chain sees it after the same exchange.
+        auto stopped = false;
+        auto exchange_deadline = this->deadline;
+
+        auto exchange = [&]() {
+            for (auto &replica : replicas) {
+                if (replica.best_solution.get_filled_bin_count() < best_solution.get_filled_bin_count()) {
+                    best_solution = replica.best_solution;
+                    this->report_new_best(best_solution);
+                }
+            }
+
+            for (auto position = exchange_round++ % 2; position + 1 < chain_count; position += 2) {
+                auto &replica_a = replicas[ladder[position]];
+                auto &replica_b = replicas[ladder[position + 1]];
+
+                auto exponent = (1 / temperatures[position] - 1 / temperatures[position + 1]) *
+                                (replica_a.solution.get_filled_bin_count() - replica_b.solution.get_filled_bin_count());
+
+                if (exponent >= 0 || this->rgen.next_double() < std::exp(exponent)) {
+                    std::swap(ladder[position], ladder[position + 1]);
+                    replica_a.ladder_position = position + 1;
+                    replica_b.ladder_position = position;
+                }
+            }
+
+            stopped = best_solution.get_filled_bin_count() <= this->lower_bound || exchange_deadline.is_expired_now();
+        };
+
+        auto barrier = Barrier{chain_count, exchange};
+
+        auto evaluation_counter = get_bound_evaluation_counter();
+        auto threads = std::vector<std::thread>{};
+        for (auto &replica : replicas) {
+            threads.emplace_back([&]() {
+                auto evaluation_scope = EvaluationCountScope{evaluation_counter};
+                auto deadline = this->deadline;
+
+                for (auto done = 0; done < iteration_count && !stopped; done += exchange_interval) {
+                    auto temperature = temperatures[replica.ladder_position];
+                    this->run_replica(replica, temperature, std::min(exchange_interval, iteration_count - done), deadline);
+                    barrier.arrive_and_wait();
+                }
+            });
+        }
+
+        for (auto &thread : threads) {
+            thread.join();
+        }
+
+        return best_solution;
+    }
+};
+
+const auto COOLING_SCHEDULE_MAP = std::map<int, CoolingSchedule>{
+    {1, InverseCooling{}},
+    {2, LogarithmicCooling{}},
+    {3, ExponentialCooling{}},
+};
+
+static auto solve_with_simulated_annealing(
+    InstancePtr instance,
+    const std::vector<int> &args,
+    const Options &options,
+    const SolveBudget &budget,
+    NewBestCb new_best_cb)
+    -> SolveResult {
+    auto seed = resolve_seed(std::stoull(options.at("seed")));
+    auto solution_factory = SimulatedAnnealingSolutionFactory{std::move(instance), Random{seed}};
+
+    auto statistics = RunStatistics{solution_factory.get_lower_bound()};
+    auto evaluation_scope = EvaluationCountScope{statistics.get_evaluation_counter()};
+    solution_factory.set_new_best_cb(make_new_best_cb(statistics, std::move(new_best_cb)));
+    solution_factory.set_deadline(Deadline{budget.time_limit_ms, budget.cancelled});
+    solution_factory.set_start(options.at("start"));
+    solution_factory.set_neighborhood(Neighborhood{
+        parse_neighborhood_type(options.at("neighborhood")),
+        get_int_option(options, "candidate-bins")});
+
+    auto solutions = std::vector<LabelledSolution>{};
+
+    if (args[2] > 1) {
+        solutions.push_back({
+            "Replica exchange solution",
+            solution_factory.generate_replica_exchange_solution(
+                args[2],
+                args[0],
+                std::max(1, args[3])),
+        });
+    } else {
+        solutions.push_back({
+            "Simulated annealing solution",
+            solution_factory.generate_simulated_annealing_solution(
+                args[0],
+                COOLING_SCHEDULE_MAP.at(args[1])),
+        });
+    }
+
+    statistics.finish();
+
+    return SolveResult{std::move(solutions), statistics, seed};
+}
+
+auto get_simulated_annealing_spec() -> AlgorithmSpec {
+    return AlgorithmSpec{
+        {
+            {
+                "Iteration count",
+                "",
+                {},
+                1000,
+                0,
+            },
+            {
+                "Algorithm",
+                "- 1 -> T ~== 1 / k"
+                "\n   - 2 -> T ~== 1 / log(k)"
+                "\n   - 3 -> T ~== 1 / a^k",
+                {map_keys_to_set(COOLING_SCHEDULE_MAP)},
+                1,
+            },
+            {
+                "Chain count",
+                "Above 1 -> replica exchange with one thread per chain, on a fixed temperature"
+                " ladder instead of the algorithm's schedule",
+                {},
+                1,
+            },
+            {
+                "Exchange interval",
+                "Iterations between replica exchanges",
+                {},
+                1000,
+            },
+        },
+        get_trajectory_solver_options(),
+        true,
+        solve_with_simulated_annealing,
+    };
+}
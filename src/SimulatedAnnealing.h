@@ -0,0 +1,9 @@
+#include "Solver.h"
+
+#ifndef SIMULATED_ANNEALING_H
+#define SIMULATED_ANNEALING_H
+
+// Spec of the "simulated-annealing" algorithm of solve().
+auto get_simulated_annealing_spec() -> AlgorithmSpec;
+
+#endif // SIMULATED_ANNEALING_H
@@ -1,80 +1,537 @@
 #include "Solution.h"
 #include "GarbageBag.h"
+#include "Genome.h"
+#include "Instance.h"
+#include "Profile.h"
+#include "Random.h"
+#include "Statistics.h"
 #include "utils.h"
+#include <algorithm>
+#include <cstdint>
 #include <iostream>
-#include <random>
 #include <vector>
 
 using GarbageBags = std::vector<GarbageBag>;
 
-auto _solution_rd = std::random_device{};
-auto _solution_rgen = std::mt19937{_solution_rd()};
+auto Solution::generate_random_bag_index(Random &rgen) -> int {
+    return rgen.next_index(this->genome.get_size());
+}
+
+// Zobrist key of a weight placed at a position, derived with splitmix64
+// instead of a position x weight table so it scales to any instance.
+inline auto hash_bag_at(int index, int weight) -> std::uint64_t {
+    auto key = ((std::uint64_t)index << 32 | (std::uint32_t)weight) + 0x9e3779b97f4a7c15ULL;
+    key = (key ^ (key >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    key = (key ^ (key >> 27)) * 0x94d049bb133111ebULL;
+    return key ^ (key >> 31);
+}
+
+Solution::Solution(InstancePtr instance)
+    : Solution(instance, Genome{instance->get_item_count()}) {
+}
+
+Solution::Solution(InstancePtr instance, Genome genome)
+    : instance(std::move(instance)),
+      genome(std::move(genome)),
+      hash(0) {
+    this->hash = this->calculate_hash();
+}
+
+auto Solution::calculate_hash() -> std::uint64_t {
+    auto weights = this->instance->get_weights();
+
+    return this->genome.visit([&](auto items, int item_count) {
+        auto hash = std::uint64_t{0};
+
+        for (auto i = 0; i < item_count; i++) {
+            hash ^= hash_bag_at(i, weights[items[i]]);
+        }
+
+        return hash;
+    });
+}
+
+auto Solution::set_items(const std::vector<int> &items) -> void {
+    this->genome.assign_items(items);
+    this->hash = this->calculate_hash();
+    this->bin_starts.clear();
+    this->bin_loads.clear();
+}
+
+auto Solution::get_garbage_bags() -> GarbageBags {
+    auto weights = this->instance->get_weights();
+
+    return this->genome.visit([&](auto items, int item_count) {
+        auto bags = GarbageBags{};
+        bags.reserve(item_count);
+
+        for (auto i = 0; i < item_count; i++) {
+            bags.push_back(GarbageBag{weights[items[i]]});
+        }
+
+        return bags;
+    });
+}
+
+auto Solution::decode_bins() -> void {
+    if (!this->bin_starts.empty()) {
+        return;
+    }
+
+    count_evaluation();
+    profile_count(ProfileCounter::FULL_DECODES);
+
+    this->bin_starts.assign(1, 0);
+    this->bin_loads.assign(1, 0);
+
+    auto weights = this->instance->get_weights();
+    auto bin_weight_limit = this->instance->get_bin_weight_limit();
+
+    this->genome.visit([&](auto items, int item_count) {
+        for (auto i = 0; i < item_count; i++) {
+            auto bag_weight = weights[items[i]];
+
+            if ((this->bin_loads.back() + bag_weight) > bin_weight_limit) {
+                this->bin_starts.push_back(i);
+                this->bin_loads.push_back(bag_weight);
+            } else {
+                this->bin_loads.back() += bag_weight;
+            }
+        }
+    });
+}
+
+auto Solution::find_bin_index(int bag_index) -> int {
+    auto it = std::upper_bound(
+        this->bin_starts.begin(),
+        this->bin_starts.end(),
+        bag_index);
+
+    return std::max(0, (int)(it - this->bin_starts.begin()) - 1);
+}
+
+// Re-decodes bins from the one preceding `first_changed_index` onward (a
+// lighter first bag may now fit into the previous bin), reading
+// weights through `weight_at`. Once a new bin starts past `last_changed_index`
+// at the same bag as a cached bin, the rest of the layout is unchanged and the
+// walk stops. Every re-decoded bin is reported to `on_bin(start, load)`.
+// Returns the index of the first reused cached bin and the new bin count.
+template <typename WeightAt, typename OnBin>
+auto Solution::redecode_bins(
+    int first_changed_index,
+    int last_changed_index,
+    WeightAt weight_at,
+    OnBin on_bin)
+    -> std::pair<int, int> {
+    auto cached_bin_count = (int)this->bin_starts.size();
+    auto bin_index = this->find_bin_index(first_changed_index - 1);
+
+    auto bin_start = this->bin_starts[bin_index];
+    auto bin_load = 0;
+    auto bin_weight_limit = this->instance->get_bin_weight_limit();
+    auto bag_count = this->genome.get_size();
+
+    for (auto i = bin_start; i < bag_count; i++) {
+        auto bag_weight = weight_at(i);
 
-auto Solution::generate_random_bag_index() -> int {
-    auto distr = std::uniform_int_distribution<int>{
-        0,
-        (int)this->garbage_bags.size() - 1};
+        if ((bin_load + bag_weight) <= bin_weight_limit) {
+            bin_load += bag_weight;
+            continue;
+        }
+
+        on_bin(bin_start, bin_load);
+        bin_index++;
+
+        if (i > last_changed_index) {
+            auto cached = std::lower_bound(
+                this->bin_starts.begin(),
+                this->bin_starts.end(),
+                i);
+
+            if (cached != this->bin_starts.end() && *cached == i) {
+                auto cached_bin_index = (int)(cached - this->bin_starts.begin());
+                return {cached_bin_index, bin_index + cached_bin_count - cached_bin_index};
+            }
+        }
+
+        bin_start = i;
+        bin_load = bag_weight;
+    }
 
-    return distr(_solution_rgen);
+    on_bin(bin_start, bin_load);
+
+    return {cached_bin_count, bin_index + 1};
 }
 
-Solution::Solution(
-    int bin_weight_limit,
-    GarbageBags garbage_bags)
-    : bin_weight_limit(bin_weight_limit),
-      garbage_bags(garbage_bags) {
+// Bin count once the bags in [first1, last1] and [first2, last2] change, with
+// first1 <= last1 < first2 and the new weights read through `weight_at`. When
+// decoding after the first segment resyncs with the cache before the second one,
+// it jumps straight to the second, so the cost does not grow with the distance
+// between them. An empty second segment (first2 > last2) is allowed.
+template <typename WeightAt>
+auto Solution::count_bins_after_changes(
+    int first1,
+    int last1,
+    int first2,
+    int last2,
+    WeightAt weight_at)
+    -> int {
+    auto cached_bin_count = (int)this->bin_starts.size();
+    auto bin_weight_limit = this->instance->get_bin_weight_limit();
+    auto bag_count = this->genome.get_size();
+
+    // New bin count minus cached bin count over the bins decoded so far.
+    auto bin_count_delta = 0;
+    auto first_changed_index = first1;
+
+    while (true) {
+        auto bin_index = this->find_bin_index(first_changed_index - 1);
+        auto new_bin_index = bin_index + bin_count_delta;
+        auto bin_load = 0;
+        auto resync_index = -1;
+
+        for (auto i = this->bin_starts[bin_index]; i < bag_count; i++) {
+            auto bag_weight = weight_at(i);
+
+            if ((bin_load + bag_weight) <= bin_weight_limit) {
+                bin_load += bag_weight;
+                continue;
+            }
+
+            new_bin_index++;
+            bin_load = bag_weight;
+
+            if (i > last1 && (i < first2 || i > last2)) {
+                auto cached = std::lower_bound(
+                    this->bin_starts.begin(),
+                    this->bin_starts.end(),
+                    i);
+
+                if (cached != this->bin_starts.end() && *cached == i) {
+                    resync_index = i;
+                    bin_count_delta = new_bin_index - (int)(cached - this->bin_starts.begin());
+                    break;
+                }
+            }
+        }
+
+        if (resync_index < 0) {
+            return new_bin_index + 1;
+        }
+
+        if (resync_index > last2 || first2 > last2) {
+            return cached_bin_count + bin_count_delta;
+        }
+
+        first_changed_index = first2;
+        last1 = last2;
+    }
 }
 
 auto Solution::swap_garbage_bags(int index1, int index2) -> void {
-    std::swap((this->garbage_bags)[index1], (this->garbage_bags)[index2]);
+    if (index1 > index2) {
+        std::swap(index1, index2);
+    }
+
+    auto weights = this->instance->get_weights();
+    auto weight1 = weights[this->genome.get_item(index1)];
+    auto weight2 = weights[this->genome.get_item(index2)];
+
+    this->genome.swap_items(index1, index2);
+
+    if (index1 == index2 || weight1 == weight2) {
+        return;
+    }
+
+    this->hash ^= hash_bag_at(index1, weight1) ^
+                  hash_bag_at(index2, weight2) ^
+                  hash_bag_at(index1, weight2) ^
+                  hash_bag_at(index2, weight1);
+
+    this->update_bins(index1, index2);
 }
 
-auto Solution::generate_neighbors() -> std::vector<Solution> {
-    auto neighbors = std::vector<Solution>{};
+auto Solution::update_bins(int first_changed_index, int last_changed_index) -> void {
+    if (this->bin_starts.empty()) {
+        this->decode_bins();
+        return;
+    }
+
+    count_evaluation();
+    profile_count(ProfileCounter::DELTA_EVALUATIONS);
 
-    auto garbage_bags_size = this->garbage_bags.size();
-    for (auto i : range(garbage_bags_size)) {
-        auto neighbor = *this;
-        neighbor.swap_garbage_bags(i, (i + 1) % garbage_bags_size);
-        neighbors.push_back(neighbor);
+    auto weights = this->instance->get_weights();
+    auto first_bin_index = this->find_bin_index(first_changed_index - 1);
+    auto &new_bin_starts = this->changed_bin_starts;
+    auto &new_bin_loads = this->changed_bin_loads;
+    new_bin_starts.clear();
+    new_bin_loads.clear();
+
+    auto [resync_bin_index, _] = this->genome.visit([&](auto items, int) {
+        return this->redecode_bins(
+            first_changed_index,
+            last_changed_index,
+            [&](int i) { return weights[items[i]]; },
+            [&](int start, int load) {
+                new_bin_starts.push_back(start);
+                new_bin_loads.push_back(load);
+            });
+    });
+
+    // Most moves keep the bin count of the changed range, so the bins are overwritten in place.
+    if ((int)new_bin_starts.size() == resync_bin_index - first_bin_index) {
+        std::copy(new_bin_starts.begin(), new_bin_starts.end(), this->bin_starts.begin() + first_bin_index);
+        std::copy(new_bin_loads.begin(), new_bin_loads.end(), this->bin_loads.begin() + first_bin_index);
+        return;
     }
 
-    return neighbors;
+    this->bin_starts.erase(
+        this->bin_starts.begin() + first_bin_index,
+        this->bin_starts.begin() + resync_bin_index);
+    this->bin_starts.insert(
+        this->bin_starts.begin() + first_bin_index,
+        new_bin_starts.begin(),
+        new_bin_starts.end());
+
+    this->bin_loads.erase(
+        this->bin_loads.begin() + first_bin_index,
+        this->bin_loads.begin() + resync_bin_index);
+    this->bin_loads.insert(
+        this->bin_loads.begin() + first_bin_index,
+        new_bin_loads.begin(),
+        new_bin_loads.end());
 }
 
-auto Solution::generate_random_neighbor() -> Solution {
-    auto neighbor = *this;
+auto Solution::evaluate_swap(int index1, int index2) -> int {
+    if (index1 > index2) {
+        std::swap(index1, index2);
+    }
+
+    auto weights = this->instance->get_weights();
+    auto weight1 = weights[this->genome.get_item(index1)];
+    auto weight2 = weights[this->genome.get_item(index2)];
+
+    if (index1 == index2 || weight1 == weight2) {
+        return this->get_filled_bin_count();
+    }
+
+    count_evaluation();
+    profile_count(ProfileCounter::DELTA_EVALUATIONS);
+    this->decode_bins();
+
+    return this->genome.visit([&](auto items, int) {
+        return this->count_bins_after_changes(
+            index1,
+            index1,
+            index2,
+            index2,
+            [&](int i) {
+                if (i == index1) {
+                    return weight2;
+                }
+
+                if (i == index2) {
+                    return weight1;
+                }
+
+                return weights[items[i]];
+            });
+    });
+}
+
+auto Solution::relocate_block(int index1, int index2, int length) -> void {
+    if (index1 == index2 || length <= 0) {
+        return;
+    }
+
+    auto weights = this->instance->get_weights();
+    auto [first, middle, last] = get_block_rotation(index1, index2, length);
+
+    this->genome.visit([&](auto items, int) {
+        for (auto i = first; i < last; i++) {
+            this->hash ^= hash_bag_at(i, weights[items[i]]);
+        }
+    });
+
+    this->genome.rotate_items(first, middle, last);
+
+    this->genome.visit([&](auto items, int) {
+        for (auto i = first; i < last; i++) {
+            this->hash ^= hash_bag_at(i, weights[items[i]]);
+        }
+    });
+
+    this->update_bins(first, last - 1);
+}
+
+auto Solution::evaluate_block_relocation(int index1, int index2, int length) -> int {
+    if (index1 == index2 || length <= 0) {
+        return this->get_filled_bin_count();
+    }
+
+    count_evaluation();
+    profile_count(ProfileCounter::DELTA_EVALUATIONS);
+    this->decode_bins();
+
+    auto weights = this->instance->get_weights();
+    auto [first, middle, last] = get_block_rotation(index1, index2, length);
+    auto shift = middle - first;
+    auto size = last - first;
+
+    return this->genome.visit([&](auto items, int) {
+        return this->count_bins_after_changes(
+            first,
+            last - 1,
+            last,
+            last - 1,
+            [&](int i) {
+                if (i < first || i >= last) {
+                    return weights[items[i]];
+                }
+
+                auto offset = i - first + shift;
+                return weights[items[first + (offset < size ? offset : offset - size)]];
+            });
+    });
+}
+
+auto Solution::get_neighborhood() -> AdjacentSwapNeighborhood {
+    return AdjacentSwapNeighborhood{this->genome.get_size()};
+}
+
+auto Solution::generate_random_move(Random &rgen) -> Move {
+    profile_count(ProfileCounter::NEIGHBORS_GENERATED);
+
+    auto random_index = this->generate_random_bag_index(rgen);
+    auto next_index = (random_index + 1) % this->genome.get_size();
+
+    return Move{random_index, next_index};
+}
+
+auto Solution::evaluate_move(const Move &move) -> int {
+    if (move.type == MoveType::BLOCK) {
+        return this->evaluate_block_relocation(move.index1, move.index2, move.length);
+    }
+
+    return this->evaluate_swap(move.index1, move.index2);
+}
+
+auto Solution::apply_move(const Move &move) -> void {
+    if (move.type == MoveType::BLOCK) {
+        this->relocate_block(move.index1, move.index2, move.length);
+        return;
+    }
 
-    auto random_index = this->generate_random_bag_index();
-    auto next_index = (random_index + 1) % this->garbage_bags.size();
+    this->swap_garbage_bags(move.index1, move.index2);
+}
+
+auto Solution::hash_move(const Move &move) -> std::uint64_t {
+    auto weights = this->instance->get_weights();
+
+    if (move.type == MoveType::BLOCK) {
+        if (move.index1 == move.index2 || move.length <= 0) {
+            return this->hash;
+        }
+
+        auto [first, middle, last] = get_block_rotation(move.index1, move.index2, move.length);
+        auto hash = this->hash;
 
-    neighbor.swap_garbage_bags(random_index, next_index);
+        this->genome.visit([&](auto items, int) {
+            for (auto i = first; i < last; i++) {
+                auto moved_from = i < last - (middle - first) ? i + (middle - first) : i - (last - middle);
+                hash ^= hash_bag_at(i, weights[items[i]]) ^ hash_bag_at(i, weights[items[moved_from]]);
+            }
+        });
+
+        return hash;
+    }
 
+    auto weight1 = weights[this->genome.get_item(move.index1)];
+    auto weight2 = weights[this->genome.get_item(move.index2)];
+
+    if (move.index1 == move.index2 || weight1 == weight2) {
+        return this->hash;
+    }
+
+    return this->hash ^
+           hash_bag_at(move.index1, weight1) ^
+           hash_bag_at(move.index2, weight2) ^
+           hash_bag_at(move.index1, weight2) ^
+           hash_bag_at(move.index2, weight1);
+}
+
+auto Solution::generate_random_neighbor(Random &rgen) -> Solution {
+    auto neighbor = *this;
+    neighbor.apply_move(this->generate_random_move(rgen));
     return neighbor;
 }
 
-auto Solution::get_bins() -> std::vector<GarbageBags> {
-    auto bins = std::vector<GarbageBags>{{}};
+auto Solution::get_bin_items() -> std::vector<std::vector<int>> {
+    auto bins = std::vector<std::vector<int>>{{}};
 
+    auto weights = this->instance->get_weights();
+    auto bin_weight_limit = this->instance->get_bin_weight_limit();
     auto weight_in_last_bin = 0;
 
-    for (auto bag : this->garbage_bags) {
-        auto bag_weight = bag.get_weight();
+    this->genome.visit([&](auto items, int item_count) {
+        for (auto i = 0; i < item_count; i++) {
+            auto bag_weight = weights[items[i]];
 
-        if ((weight_in_last_bin + bag_weight) > this->bin_weight_limit) {
-            bins.push_back({std::move(bag)});
-            weight_in_last_bin = bag_weight;
-        } else {
-            bins.back().push_back(std::move(bag));
-            weight_in_last_bin += bag_weight;
+            if ((weight_in_last_bin + bag_weight) > bin_weight_limit) {
+                bins.push_back({(int)items[i]});
+                weight_in_last_bin = bag_weight;
+            } else {
+                bins.back().push_back(items[i]);
+                weight_in_last_bin += bag_weight;
+            }
+        }
+    });
+
+    return bins;
+}
+
+auto Solution::get_bins() -> std::vector<GarbageBags> {
+    auto bins = std::vector<GarbageBags>{};
+
+    for (auto &bin_items : this->get_bin_items()) {
+        auto &bin = bins.emplace_back();
+
+        for (auto item : bin_items) {
+            bin.push_back(GarbageBag{this->instance->get_weight(item)});
         }
     }
 
     return bins;
 }
 
+auto Solution::get_bin_starts() -> const std::vector<int> & {
+    this->decode_bins();
+    return this->bin_starts;
+}
+
+auto Solution::get_bin_loads() -> const std::vector<int> & {
+    this->decode_bins();
+    return this->bin_loads;
+}
+
 auto Solution::get_filled_bin_count() -> int {
-    return this->get_bins().size();
+    if (this->bin_starts.empty()) {
+        return this->count_filled_bins();
+    }
+
+    return this->bin_starts.size();
+}
+
+auto Solution::count_filled_bins() -> int {
+    count_evaluation();
+    profile_count(ProfileCounter::FULL_DECODES);
+
+    auto weights = this->instance->get_weights();
+    auto bin_weight_limit = this->instance->get_bin_weight_limit();
+
+    return this->genome.visit([&](auto items, int item_count) {
+        return ::count_filled_bins(weights, items, item_count, bin_weight_limit);
+    });
 }
 
 auto Solution::to_string() -> std::string {
@@ -108,10 +565,6 @@ auto Solution::to_string() -> std::string {
     return str;
 }
 
-auto Solution::operator=(Solution solution) -> void {
-    this->garbage_bags = solution.get_garbage_bags();
-}
-
 std::ostream &operator<<(std::ostream &o, Solution solution) {
     o << solution.to_string().c_str();
     return o;
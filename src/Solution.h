@@ -1,7 +1,13 @@
 #include "GarbageBag.h"
+#include "Genome.h"
+#include "Instance.h"
+#include "Move.h"
+#include "Profile.h"
+#include "Random.h"
 #include "utils.h"
+#include <cstdint>
 #include <iostream>
-#include <random>
+#include <utility>
 #include <vector>
 
 #ifndef SOLUTION_H
@@ -9,35 +15,140 @@
 
 using GarbageBags = std::vector<GarbageBag>;
 
+// Counts next-fit bins of the items in the given order without materializing them.
+template <typename Index>
+inline auto count_filled_bins(
+    const int *weights,
+    const Index *items,
+    int item_count,
+    int bin_weight_limit)
+    -> int {
+    auto bin_count = 1;
+    auto weight_in_last_bin = 0;
+
+    for (auto i = 0; i < item_count; i++) {
+        auto bag_weight = weights[items[i]];
+        auto overflows = (weight_in_last_bin + bag_weight) > bin_weight_limit;
+
+        bin_count += overflows;
+        weight_in_last_bin = overflows ? bag_weight : weight_in_last_bin + bag_weight;
+    }
+
+    return bin_count;
+}
+
 class Solution {
 private:
-    const int bin_weight_limit;
-    GarbageBags garbage_bags;
+    InstancePtr instance;
+    Genome genome;
+    // Zobrist-style hash of the weight order, kept up to date across swaps.
+    std::uint64_t hash;
+
+    // Next-fit decoding cache: index of the first bag and total weight of every bin.
+    // Empty until the first swap, so solutions that are only counted never allocate it.
+    std::vector<int> bin_starts;
+    std::vector<int> bin_loads;
+    // Bins re-decoded by update_bins(); kept so applying moves does not allocate.
+    std::vector<int> changed_bin_starts;
+    std::vector<int> changed_bin_loads;
+#ifdef MHE_PROFILE
+    ProfileCopyCounter copy_counter;
+#endif
+
+    auto generate_random_bag_index(Random &rgen) -> int;
+
+    auto calculate_hash() -> std::uint64_t;
 
-    auto generate_random_bag_index() -> int;
+    auto decode_bins() -> void;
+
+    auto find_bin_index(int bag_index) -> int;
+
+    template <typename WeightAt, typename OnBin>
+    auto redecode_bins(
+        int first_changed_index,
+        int last_changed_index,
+        WeightAt weight_at,
+        OnBin on_bin)
+        -> std::pair<int, int>;
+
+    template <typename WeightAt>
+    auto count_bins_after_changes(
+        int first1,
+        int last1,
+        int first2,
+        int last2,
+        WeightAt weight_at)
+        -> int;
+
+    // Re-decodes the cached bins after the bags in [first_changed_index, last_changed_index] changed.
+    auto update_bins(int first_changed_index, int last_changed_index) -> void;
 
 public:
-    Solution(
-        int bin_weight_limit,
-        GarbageBags garbage_bags);
+    // Items in instance order.
+    explicit Solution(InstancePtr instance);
 
-    inline auto get_garbage_bags() -> GarbageBags {
-        return this->garbage_bags;
+    Solution(InstancePtr instance, Genome genome);
+
+    inline auto get_instance() -> const InstancePtr & {
+        return this->instance;
+    }
+
+    inline auto get_genome() -> const Genome & {
+        return this->genome;
     }
 
+    // Replaces the genome in place; the genome and bin cache keep their storage.
+    auto set_items(const std::vector<int> &items) -> void;
+
+    inline auto get_hash() -> std::uint64_t {
+        return this->hash;
+    }
+
+    auto get_garbage_bags() -> GarbageBags;
+
     auto swap_garbage_bags(int index1, int index2) -> void;
 
-    auto generate_neighbors() -> std::vector<Solution>;
+    // Filled bin count after swapping the given bags, without applying the swap.
+    auto evaluate_swap(int index1, int index2) -> int;
+
+    // Moves the `length` bags starting at `index1` so that they start at `index2`.
+    auto relocate_block(int index1, int index2, int length) -> void;
+
+    // Filled bin count after relocating the block, without applying it.
+    auto evaluate_block_relocation(int index1, int index2, int length) -> int;
+
+    auto get_neighborhood() -> AdjacentSwapNeighborhood;
+
+    auto generate_random_move(Random &rgen) -> Move;
+
+    // Filled bin count after the move, without applying it.
+    auto evaluate_move(const Move &move) -> int;
 
-    auto generate_random_neighbor() -> Solution;
+    auto apply_move(const Move &move) -> void;
 
+    // Hash of the solution after the move, without applying it.
+    auto hash_move(const Move &move) -> std::uint64_t;
+
+    auto generate_random_neighbor(Random &rgen) -> Solution;
+
+    // Item indexes of every next-fit bin.
+    auto get_bin_items() -> std::vector<std::vector<int>>;
+
+    // Materializes the bins; meant for printing only.
     auto get_bins() -> std::vector<GarbageBags>;
 
     auto get_filled_bin_count() -> int;
 
-    auto to_string() -> std::string;
+    // First bag of every next-fit bin.
+    auto get_bin_starts() -> const std::vector<int> &;
 
-    auto operator=(Solution solution) -> void;
+    // Total weight of every next-fit bin.
+    auto get_bin_loads() -> const std::vector<int> &;
+
+    // Full allocation-free decode, ignoring the bin cache.
+    auto count_filled_bins() -> int;
+
+    auto to_string() -> std::string;
 };
 
 std::ostream &operator<<(std::ostream &o, Solution solution);
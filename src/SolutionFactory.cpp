@@ -0,0 +1,37 @@
+#include "SolutionFactory.h"
+#include "Constructive.h"
+#include "LowerBound.h"
+#include <string>
+#include <utility>
+
+SolutionFactory::SolutionFactory(InstancePtr instance)
+    : instance(std::move(instance)),
+      lower_bound(calculate_lower_bound(*this->instance)),
+      start_genome(this->instance->get_item_count()) {
+}
+
+auto SolutionFactory::report_new_best(Solution &solution) -> void {
+    if (this->new_best_cb) {
+        this->new_best_cb(solution);
+    }
+}
+
+auto SolutionFactory::set_new_best_cb(NewBestCb new_best_cb) -> void {
+    this->new_best_cb = std::move(new_best_cb);
+}
+
+auto SolutionFactory::set_deadline(Deadline deadline) -> void {
+    this->deadline = deadline;
+}
+
+auto SolutionFactory::get_lower_bound() -> int {
+    return this->lower_bound;
+}
+
+auto SolutionFactory::set_start(const std::string &start) -> void {
+    this->start_genome = build_start_genome(start, *this->instance);
+}
+
+auto TrajectorySolutionFactory::set_neighborhood(Neighborhood neighborhood) -> void {
+    this->neighborhood = neighborhood;
+}
@@ -0,0 +1,52 @@
+#include "Deadline.h"
+#include "Genome.h"
+#include "Instance.h"
+#include "Neighborhood.h"
+#include "Solution.h"
+#include "Statistics.h"
+#include <string>
+
+#ifndef SOLUTION_FACTORY_H
+#define SOLUTION_FACTORY_H
+
+// State and setters shared by the solution factories of every solver. The
+// solve_with_* functions configure a factory through the setters before
+// generating solutions from it.
+class SolutionFactory {
+protected:
+    InstancePtr instance;
+    // Runs stop as soon as the best solution reaches it, as no solution can do better.
+    int lower_bound;
+    // Genome every run starts from; instance order until set_start() is called.
+    Genome start_genome;
+    NewBestCb new_best_cb;
+    Deadline deadline;
+
+    auto report_new_best(Solution &solution) -> void;
+
+public:
+    explicit SolutionFactory(InstancePtr instance);
+
+    auto set_new_best_cb(NewBestCb new_best_cb) -> void;
+
+    auto set_deadline(Deadline deadline) -> void;
+
+    auto get_lower_bound() -> int;
+
+    // See build_start_genome.
+    auto set_start(const std::string &start) -> void;
+};
+
+// Factories of the solvers running on the trajectory engine, which also move
+// through a neighborhood.
+class TrajectorySolutionFactory : public SolutionFactory {
+protected:
+    Neighborhood neighborhood;
+
+public:
+    using SolutionFactory::SolutionFactory;
+
+    auto set_neighborhood(Neighborhood neighborhood) -> void;
+};
+
+#endif // SOLUTION_FACTORY_H
@@ -0,0 +1,166 @@
+#include "Solver.h"
+#include "GeneticAlgorithm.h"
+#include "HillClimbing.h"
+#include "Instance.h"
+#include "SimulatedAnnealing.h"
+#include "Solution.h"
+#include "TabuSearch.h"
+#include "ThreadPool.h"
+#include "utils.h"
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+auto SolveWorkspace::get_thread_pool(int thread_count) -> ThreadPool & {
+    auto &thread_pool = this->thread_pools[resolve_thread_count(thread_count)];
+
+    if (!thread_pool) {
+        thread_pool = std::make_unique<ThreadPool>(thread_count);
+    }
+
+    return *thread_pool;
+}
+
+auto SolveWorkspace::get_weight_buffer() -> std::shared_ptr<std::vector<int>> {
+    for (auto &weight_buffer : this->weight_buffers) {
+        if (weight_buffer.use_count() == 1) {
+            return weight_buffer;
+        }
+    }
+
+    return this->weight_buffers.emplace_back(std::make_shared<std::vector<int>>());
+}
+
+auto SolveResult::get_best_solution() -> Solution & {
+    auto *best_solution = &this->solutions.front().solution;
+
+    for (auto &labelled_solution : this->solutions) {
+        if (labelled_solution.solution.get_filled_bin_count() < best_solution->get_filled_bin_count()) {
+            best_solution = &labelled_solution.solution;
+        }
+    }
+
+    return *best_solution;
+}
+
+// Built on first use, as the specs read the operator maps of other translation units.
+static auto get_algorithm_spec_map() -> const std::map<std::string, AlgorithmSpec> & {
+    static const auto algorithm_spec_map = std::map<std::string, AlgorithmSpec>{
+        {"genetic-algorithm", get_genetic_algorithm_spec()},
+        {"hill-climbing", get_hill_climbing_spec()},
+        {"simulated-annealing", get_simulated_annealing_spec()},
+        {"tabu-search", get_tabu_search_spec()},
+    };
+
+    return algorithm_spec_map;
+}
+
+auto get_algorithm_names() -> std::vector<std::string> {
+    auto names = std::vector<std::string>{};
+
+    for (auto &[name, _] : get_algorithm_spec_map()) {
+        names.push_back(name);
+    }
+
+    return names;
+}
+
+auto get_algorithm_spec(const std::string &algorithm) -> const AlgorithmSpec & {
+    auto &algorithm_spec_map = get_algorithm_spec_map();
+    auto spec = algorithm_spec_map.find(algorithm);
+
+    if (spec == algorithm_spec_map.end()) {
+        throw std::invalid_argument{"Unknown algorithm: " + algorithm};
+    }
+
+    return spec->second;
+}
+
+// The solvers assume at least one item and that every item fits into an empty bin.
+static auto validate_instance(const Instance &instance) -> void {
+    if (!instance.get_item_count()) {
+        throw std::invalid_argument{"Instance has no items"};
+    }
+
+    if (instance.get_bin_weight_limit() <= 0) {
+        throw std::invalid_argument{
+            "Bin weight limit not greater than 0: " + std::to_string(instance.get_bin_weight_limit())};
+    }
+
+    for (auto i : range(instance.get_item_count())) {
+        auto weight = instance.get_weight(i);
+
+        if (weight <= 0 || weight > instance.get_bin_weight_limit()) {
+            throw std::invalid_argument{
+                "Weight of item " + std::to_string(i) + " not in (0, bin weight limit]: " + std::to_string(weight)};
+        }
+    }
+}
+
+auto resolve_args(const std::string &algorithm, const std::vector<int> &args) -> std::vector<int> {
+    auto &spec = get_algorithm_spec(algorithm);
+
+    if (args.size() > spec.expected_args.size()) {
+        throw std::invalid_argument{
+            "Too many args for " + algorithm + ": " + std::to_string(args.size()) +
+            " (at most " + std::to_string(spec.expected_args.size()) + ")"};
+    }
+
+    auto resolved_args = std::vector<int>{};
+
+    for (auto i : range(spec.expected_args.size())) {
+        auto &expected_arg = spec.expected_args[i];
+
+        if (i >= (int)args.size()) {
+            resolved_args.push_back(expected_arg.default_value);
+            continue;
+        }
+
+        auto value = args[i];
+
+        if (expected_arg.allowed_values.size() &&
+            expected_arg.allowed_values.find(value) == expected_arg.allowed_values.end()) {
+            throw std::invalid_argument{"Invalid value of " + expected_arg.name + ": " + std::to_string(value)};
+        }
+
+        if (value < expected_arg.min_value) {
+            throw std::invalid_argument{
+                "Invalid value of " + expected_arg.name + ": " + std::to_string(value) +
+                " (at least " + std::to_string(expected_arg.min_value) + ")"};
+        }
+
+        resolved_args.push_back(value);
+    }
+
+    return resolved_args;
+}
+
+auto solve(
+    InstancePtr instance,
+    const std::string &algorithm,
+    const SolveParams &params,
+    const SolveBudget &budget)
+    -> SolveResult {
+    auto &spec = get_algorithm_spec(algorithm);
+    validate_instance(*instance);
+    auto args = resolve_args(algorithm, params.args);
+
+    auto options = Options{};
+
+    for (auto &expected_option : spec.expected_options) {
+        options[expected_option.name] = expected_option.default_value;
+    }
+
+    for (auto &[name, value] : params.options) {
+        if (options.find(name) == options.end()) {
+            throw std::invalid_argument{"Unknown option of " + algorithm + ": " + name};
+        }
+
+        options[name] = value;
+    }
+
+    return spec.solve_cb(std::move(instance), args, options, budget, params.new_best_cb);
+}
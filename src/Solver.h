@@ -0,0 +1,112 @@
+#include "Instance.h"
+#include "Solution.h"
+#include "Statistics.h"
+#include "ThreadPool.h"
+#include "utils.h"
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#ifndef SOLVER_H
+#define SOLVER_H
+
+// In-process API of libmhe. Every call of solve() owns its state, so runs may
+// overlap on different threads; nothing is printed.
+
+struct SolveParams {
+    // Positional args of the algorithm's CLI; missing ones take their defaults.
+    std::vector<int> args;
+    // `--name value` options of the algorithm's CLI, without the dashes; missing
+    // ones take their defaults. The instance, output and time limit options are
+    // only read by the CLI.
+    Options options;
+    // Called with every new best, from the solver's threads.
+    NewBestCb new_best_cb;
+};
+
+// Threads and buffers kept between runs, e.g. by a batch worker, so the
+// thread-local scratch of the solvers' pool threads and the capacity of
+// instance weight buffers outlive each run. Not for overlapping runs.
+class SolveWorkspace {
+private:
+    std::map<int, std::unique_ptr<ThreadPool>> thread_pools;
+    std::vector<std::shared_ptr<std::vector<int>>> weight_buffers;
+
+public:
+    // Pool of `thread_count` threads, resolved like ThreadPool's; started on first use.
+    auto get_thread_pool(int thread_count) -> ThreadPool &;
+
+    // Buffer for load_instance() that no live instance holds any more.
+    auto get_weight_buffer() -> std::shared_ptr<std::vector<int>>;
+};
+
+struct SolveBudget {
+    // Wall-clock limit of the run; not greater than 0 means no limit.
+    int time_limit_ms = 0;
+    // Set from any thread to stop the run early with the best solution so far;
+    // must outlive the run.
+    const std::atomic<bool> *cancelled = nullptr;
+    // Threads the run may reuse instead of starting its own; must outlive the run.
+    SolveWorkspace *workspace = nullptr;
+};
+
+struct LabelledSolution {
+    std::string label;
+    Solution solution;
+};
+
+struct SolveResult {
+    // Every solution the algorithm generates, in order, e.g. tabu search without
+    // and with backtracking.
+    std::vector<LabelledSolution> solutions;
+    RunStatistics statistics;
+    // Seed the run drew from, with 0 resolved; 0 for deterministic algorithms.
+    std::uint64_t seed;
+
+    // First solution with the fewest filled bins.
+    auto get_best_solution() -> Solution &;
+};
+
+// Runs an algorithm with args and options completed from its spec.
+using SolveCb = std::function<SolveResult(
+    InstancePtr instance,
+    const std::vector<int> &args,
+    const Options &options,
+    const SolveBudget &budget,
+    NewBestCb new_best_cb)>;
+
+struct AlgorithmSpec {
+    std::vector<ExpectedArg> expected_args;
+    std::vector<ExpectedOption> expected_options;
+    // Whether the seed option changes the run.
+    bool randomized;
+    SolveCb solve_cb;
+};
+
+// Names are the ones of the CLIs, e.g. "hill-climbing".
+auto get_algorithm_names() -> std::vector<std::string>;
+
+// Throws std::invalid_argument for an unknown algorithm.
+auto get_algorithm_spec(const std::string &algorithm) -> const AlgorithmSpec &;
+
+// Args of an algorithm with the missing ones set to their defaults. Throws
+// std::invalid_argument for an unknown algorithm, surplus args and arg values
+// outside the allowed ones or below their minimum.
+auto resolve_args(const std::string &algorithm, const std::vector<int> &args) -> std::vector<int>;
+
+// Throws std::invalid_argument for an unknown algorithm or option, surplus args,
+// arg values outside the allowed ones or below their minimum, and an instance
+// that is empty, has a bin weight limit not greater than 0 or an item weight
+// outside (0, bin weight limit].
+auto solve(
+    InstancePtr instance,
+    const std::string &algorithm,
+    const SolveParams &params,
+    const SolveBudget &budget = SolveBudget{})
+    -> SolveResult;
+
+#endif // SOLVER_H
@@ -0,0 +1,152 @@
+#include "SolverCli.h"
+#include "Batch.h"
+#include "Profile.h"
+#include "Solution.h"
+#include "Solver.h"
+#include "Statistics.h"
+#include "utils.h"
+#include <chrono>
+#include <exception>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Prints every new best right away, so a caller can take the latest one at any moment.
+static auto make_streaming_new_best_cb() -> NewBestCb {
+    auto start = std::chrono::steady_clock::now();
+
+    return [start](Solution &solution) {
+        auto elapsed_ms = std::chrono::duration<double, std::milli>{
+            std::chrono::steady_clock::now() - start}
+                              .count();
+
+        std::cout
+            << "New best (elapsed_ms=" << elapsed_ms << "): "
+            << solution.to_string()
+            << std::endl;
+    };
+}
+
+// Options of the CLI only, which solve() does not take.
+static auto get_batch_options() -> std::vector<ExpectedOption> {
+    return {
+        {
+            "batch",
+            "Directory of instances, or manifest of `path [capacity]` lines; set -> solve every instance"
+            " with the same args and options instead of --data, largest first. Results go to --batch-output",
+            "",
+        },
+        {
+            "batch-output",
+            "Per-instance results, written as each one finishes: JSON lines when it ends with .jsonl,"
+            " otherwise CSV; empty -> CSV on stdout",
+            "",
+        },
+        {
+            "batch-jobs",
+            "Instances solved at once; not greater than 0 means one per hardware thread."
+            " Solvers with a thread count arg should then run on 1 thread",
+            "0",
+        },
+    };
+}
+
+static auto run_batch_cli(
+    const std::string &algorithm,
+    const std::vector<int> &args,
+    const Options &options,
+    const Options &batch_options)
+    -> int {
+    auto jobs = collect_batch_jobs(batch_options.at("batch"), get_int_option(options, "capacity"));
+
+    auto failed_job_count = run_batch(
+        jobs,
+        algorithm,
+        SolveParams{args, options, nullptr},
+        SolveBudget{get_int_option(options, "time-limit-ms")},
+        get_int_option(batch_options, "batch-jobs"),
+        batch_options.at("batch-output"));
+
+    if (failed_job_count) {
+        std::cerr << failed_job_count << " of " << jobs.size() << " instances failed" << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
+
+static auto run_solver(const std::string &algorithm, int argc, char *argv[]) -> int {
+    auto &spec = get_algorithm_spec(algorithm);
+
+    auto expected_options = spec.expected_options;
+    auto batch_expected_options = get_batch_options();
+    expected_options.insert(expected_options.end(), batch_expected_options.begin(), batch_expected_options.end());
+
+    auto options = collect_options(expected_options, argc, argv);
+    // Batch results may go to stdout, so the configuration and seed go to stderr instead.
+    auto &configuration_out = options["batch"].empty() ? std::cout : std::cerr;
+    auto args = collect_args(spec.expected_args, argc, argv, configuration_out);
+
+    if (!args.size()) {
+        return 0;
+    }
+
+    auto batch_options = Options{};
+    for (auto &expected_option : batch_expected_options) {
+        batch_options[expected_option.name] = options[expected_option.name];
+        options.erase(expected_option.name);
+    }
+
+    // Resolved here, so a random seed is printed before the run and can be replayed.
+    if (spec.randomized) {
+        options["seed"] = std::to_string(get_seed_option(options, configuration_out));
+    }
+
+    if (!batch_options["batch"].empty()) {
+        return run_batch_cli(algorithm, args, options, batch_options);
+    }
+
+    auto instance = load_instance(options);
+
+    auto params = SolveParams{args, options, nullptr};
+    if (get_int_option(options, "stream")) {
+        params.new_best_cb = make_streaming_new_best_cb();
+    }
+
+    // The profile covers the run alone, not the instance loading.
+    reset_profile();
+    auto result = solve(instance, algorithm, params, SolveBudget{get_int_option(options, "time-limit-ms")});
+
+    for (auto i : range(result.solutions.size())) {
+        if (i) {
+            std::cout << std::endl;
+        }
+
+        std::cout
+            << result.solutions[i].label << ":"
+            << std::endl
+            << result.solutions[i].solution
+            << std::endl;
+    }
+
+    std::cout << result.statistics.to_gap_string() << std::endl;
+
+    if (get_int_option(options, "statistics")) {
+        std::cout << result.statistics.to_string() << std::endl;
+    }
+
+    if (!options["profile"].empty()) {
+        write_profile(options["profile"], algorithm, result.statistics.get_evaluation_count());
+    }
+
+    return 0;
+}
+
+auto run_solver_cli(const std::string &algorithm, int argc, char *argv[]) -> int {
+    try {
+        return run_solver(algorithm, argc, argv);
+    } catch (const std::exception &error) {
+        std::cerr << "Error: " << error.what() << std::endl;
+        return 1;
+    }
+}
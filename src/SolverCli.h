@@ -0,0 +1,11 @@
+#include <string>
+
+#ifndef SOLVER_CLI_H
+#define SOLVER_CLI_H
+
+// Shared main() of the solver binaries: reads the algorithm's args and options,
+// runs solve() on the selected instance and prints the outcome. Errors are
+// printed to stderr with exit code 1.
+auto run_solver_cli(const std::string &algorithm, int argc, char *argv[]) -> int;
+
+#endif // SOLVER_CLI_H
@@ -0,0 +1,209 @@
+#include "Statistics.h"
+#include "Solution.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <algorithm>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Counters keep their totals after their threads exit, so there are only as
+// many as threads ever ran at once; the free ones wait in _free_evaluation_counters.
+auto _evaluation_counters = std::list<std::atomic<std::uint64_t>>{};
+auto _free_evaluation_counters = std::vector<std::atomic<std::uint64_t> *>{};
+auto _evaluation_counters_mutex = std::mutex{};
+
+EvaluationCounterSlot::EvaluationCounterSlot() {
+    auto lock = std::lock_guard<std::mutex>{_evaluation_counters_mutex};
+
+    if (_free_evaluation_counters.empty()) {
+        this->counter = &_evaluation_counters.emplace_back(0);
+    } else {
+        this->counter = _free_evaluation_counters.back();
+        _free_evaluation_counters.pop_back();
+    }
+}
+
+EvaluationCounterSlot::~EvaluationCounterSlot() {
+    auto lock = std::lock_guard<std::mutex>{_evaluation_counters_mutex};
+    _free_evaluation_counters.push_back(this->counter);
+}
+
+auto get_evaluation_count() -> std::uint64_t {
+    auto lock = std::lock_guard<std::mutex>{_evaluation_counters_mutex};
+
+    auto evaluation_count = std::uint64_t{0};
+    for (auto &counter : _evaluation_counters) {
+        evaluation_count += counter.load(std::memory_order_relaxed);
+    }
+
+    return evaluation_count;
+}
+
+// Innermost scope of the thread; the ones it paused are reached through `outer`.
+thread_local EvaluationCountScope *_evaluation_count_scope = nullptr;
+
+EvaluationCounter::EvaluationCounter()
+    : detached_count(0) {
+}
+
+auto EvaluationCounter::get_count() -> std::uint64_t {
+    auto lock = std::lock_guard<std::mutex>{this->mutex};
+
+    auto count = this->detached_count;
+    for (auto *scope : this->scopes) {
+        count += scope->thread_counter->load(std::memory_order_relaxed) - scope->start_count;
+    }
+
+    return count;
+}
+
+EvaluationCountScope::EvaluationCountScope(EvaluationCounter *counter)
+    : counter(counter),
+      outer(_evaluation_count_scope),
+      thread_counter(&get_thread_evaluation_counter()),
+      start_count(0) {
+    if (this->outer) {
+        this->outer->detach();
+    }
+
+    this->attach();
+    _evaluation_count_scope = this;
+}
+
+EvaluationCountScope::~EvaluationCountScope() {
+    this->detach();
+    _evaluation_count_scope = this->outer;
+
+    if (this->outer) {
+        this->outer->attach();
+    }
+}
+
+auto EvaluationCountScope::attach() -> void {
+    if (!this->counter) {
+        return;
+    }
+
+    auto lock = std::lock_guard<std::mutex>{this->counter->mutex};
+    this->start_count = this->thread_counter->load(std::memory_order_relaxed);
+    this->counter->scopes.push_back(this);
+}
+
+auto EvaluationCountScope::detach() -> void {
+    if (!this->counter) {
+        return;
+    }
+
+    auto lock = std::lock_guard<std::mutex>{this->counter->mutex};
+    this->counter->detached_count += this->thread_counter->load(std::memory_order_relaxed) - this->start_count;
+
+    auto &scopes = this->counter->scopes;
+    scopes.erase(std::find(scopes.begin(), scopes.end(), this));
+}
+
+auto get_bound_evaluation_counter() -> EvaluationCounter * {
+    if (!_evaluation_count_scope) {
+        return nullptr;
+    }
+
+    return _evaluation_count_scope->get_counter();
+}
+
+RunStatistics::RunStatistics(int lower_bound)
+    : start(std::chrono::steady_clock::now()),
+      evaluation_counter(std::make_shared<EvaluationCounter>()),
+      lower_bound(lower_bound),
+      best_filled_bin_count(std::numeric_limits<int>::max()),
+      time_to_best_ms(0),
+      finished(false),
+      elapsed_ms(0),
+      evaluation_count(0) {
+}
+
+auto RunStatistics::get_elapsed_ms() -> double {
+    if (this->finished) {
+        return this->elapsed_ms;
+    }
+
+    return std::chrono::duration<double, std::milli>{
+        std::chrono::steady_clock::now() - this->start}
+        .count();
+}
+
+auto RunStatistics::get_evaluation_counter() -> EvaluationCounter * {
+    return this->evaluation_counter.get();
+}
+
+auto RunStatistics::get_evaluation_count() -> std::uint64_t {
+    if (this->finished) {
+        return this->evaluation_count;
+    }
+
+    return this->evaluation_counter->get_count();
+}
+
+auto RunStatistics::get_lower_bound() -> int {
+    return this->lower_bound;
+}
+
+auto RunStatistics::get_best_filled_bin_count() -> int {
+    return this->best_filled_bin_count;
+}
+
+auto RunStatistics::get_time_to_best_ms() -> double {
+    return this->time_to_best_ms;
+}
+
+auto RunStatistics::record_solution(Solution &solution) -> void {
+    auto filled_bin_count = solution.get_filled_bin_count();
+
+    if (filled_bin_count < this->best_filled_bin_count) {
+        this->best_filled_bin_count = filled_bin_count;
+        this->time_to_best_ms = this->get_elapsed_ms();
+    }
+}
+
+auto RunStatistics::finish() -> void {
+    this->elapsed_ms = this->get_elapsed_ms();
+    this->evaluation_count = this->get_evaluation_count();
+    this->finished = true;
+}
+
+auto RunStatistics::to_string() -> std::string {
+    auto str = std::string{"Statistics:"};
+
+    str += " evaluations=" + std::to_string(this->get_evaluation_count());
+    str += " elapsed_ms=" + std::to_string(this->get_elapsed_ms());
+    str += " best_bins=" + std::to_string(this->best_filled_bin_count);
+    str += " time_to_best_ms=" + std::to_string(this->time_to_best_ms);
+    str += " lower_bound=" + std::to_string(this->lower_bound);
+    str += " gap=" + std::to_string(this->best_filled_bin_count - this->lower_bound);
+
+    return str;
+}
+
+auto RunStatistics::to_gap_string() -> std::string {
+    auto gap = this->best_filled_bin_count - this->lower_bound;
+
+    if (!gap) {
+        return "Lower bound of " + std::to_string(this->lower_bound) + " bins reached, the solution is optimal";
+    }
+
+    return "Lower bound: " + std::to_string(this->lower_bound) + " bins (gap: " + std::to_string(gap) + ")";
+}
+
+auto make_new_best_cb(RunStatistics &statistics, NewBestCb next_cb) -> NewBestCb {
+    return [&statistics, next_cb = std::move(next_cb)](Solution &solution) {
+        statistics.record_solution(solution);
+
+        if (next_cb) {
+            next_cb(solution);
+        }
+    };
+}
@@ -0,0 +1,156 @@
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#ifndef STATISTICS_H
+#define STATISTICS_H
+
+class Solution;
+
+// Called by solvers whenever they find a solution better than every previous one.
+using NewBestCb = std::function<void(Solution &)>;
+
+// Evaluation counter of one thread; every thread gets its own slot so counting
+// never contends, and get_evaluation_count() sums all of them. A slot is handed
+// back with its count when the thread exits, and the next new thread reuses it.
+class EvaluationCounterSlot {
+private:
+    std::atomic<std::uint64_t> *counter;
+
+public:
+    EvaluationCounterSlot();
+
+    EvaluationCounterSlot(const EvaluationCounterSlot &) = delete;
+
+    auto operator=(const EvaluationCounterSlot &) -> EvaluationCounterSlot & = delete;
+
+    ~EvaluationCounterSlot();
+
+    auto get_counter() -> std::atomic<std::uint64_t> & {
+        return *this->counter;
+    }
+};
+
+inline auto get_thread_evaluation_counter() -> std::atomic<std::uint64_t> & {
+    thread_local EvaluationCounterSlot slot;
+    return slot.get_counter();
+}
+
+inline auto count_evaluation(std::uint64_t count = 1) -> void {
+    auto &counter = get_thread_evaluation_counter();
+    counter.store(counter.load(std::memory_order_relaxed) + count, std::memory_order_relaxed);
+}
+
+// Evaluations of every thread of the process.
+auto get_evaluation_count() -> std::uint64_t;
+
+class EvaluationCountScope;
+
+// Evaluations of one run: what its threads counted while bound to it by an
+// EvaluationCountScope, so overlapping runs never count each other's evaluations.
+class EvaluationCounter {
+private:
+    std::mutex mutex;
+    // Counted by scopes that are no longer attached.
+    std::uint64_t detached_count;
+    std::vector<EvaluationCountScope *> scopes;
+
+    friend class EvaluationCountScope;
+
+public:
+    EvaluationCounter();
+
+    EvaluationCounter(const EvaluationCounter &) = delete;
+
+    auto operator=(const EvaluationCounter &) -> EvaluationCounter & = delete;
+
+    auto get_count() -> std::uint64_t;
+};
+
+// Binds the calling thread to `counter` until destroyed; a null counter binds it
+// to none. A scope nested on the same thread pauses the outer one, so nothing is
+// counted twice.
+class EvaluationCountScope {
+private:
+    EvaluationCounter *counter;
+    EvaluationCountScope *outer;
+    std::atomic<std::uint64_t> *thread_counter;
+    // Thread counter value when the scope was last attached.
+    std::uint64_t start_count;
+
+    auto attach() -> void;
+
+    auto detach() -> void;
+
+    friend class EvaluationCounter;
+
+public:
+    explicit EvaluationCountScope(EvaluationCounter *counter);
+
+    EvaluationCountScope(const EvaluationCountScope &) = delete;
+
+    auto operator=(const EvaluationCountScope &) -> EvaluationCountScope & = delete;
+
+    ~EvaluationCountScope();
+
+    auto get_counter() -> EvaluationCounter * {
+        return this->counter;
+    }
+};
+
+// Counter the calling thread is bound to, or null. Solvers pass it on to the
+// threads they start, which bind to it as well.
+auto get_bound_evaluation_counter() -> EvaluationCounter *;
+
+// Progress of one solver run, printed by the --statistics option.
+class RunStatistics {
+private:
+    std::chrono::steady_clock::time_point start;
+    // Shared by copies, as solve() returns the statistics by value.
+    std::shared_ptr<EvaluationCounter> evaluation_counter;
+    int lower_bound;
+    int best_filled_bin_count;
+    double time_to_best_ms;
+    // Frozen by finish(); read live until then.
+    bool finished;
+    double elapsed_ms;
+    std::uint64_t evaluation_count;
+
+public:
+    explicit RunStatistics(int lower_bound);
+
+    auto get_elapsed_ms() -> double;
+
+    // Solvers bind the threads of the run to it with EvaluationCountScope.
+    auto get_evaluation_counter() -> EvaluationCounter *;
+
+    // Evaluations counted by the threads bound to the run's counter.
+    auto get_evaluation_count() -> std::uint64_t;
+
+    auto get_lower_bound() -> int;
+
+    auto get_best_filled_bin_count() -> int;
+
+    auto get_time_to_best_ms() -> double;
+
+    auto record_solution(Solution &solution) -> void;
+
+    // Stops the clock and the evaluation count at the end of the run.
+    auto finish() -> void;
+
+    // Single `Statistics: key=value ...` line, parsed by the benchmark suite.
+    auto to_string() -> std::string;
+
+    // Lower bound line printed after every solution.
+    auto to_gap_string() -> std::string;
+};
+
+// Records every new best in `statistics`, then passes it on to `next_cb` if set.
+auto make_new_best_cb(RunStatistics &statistics, NewBestCb next_cb) -> NewBestCb;
+
+#endif // STATISTICS_H
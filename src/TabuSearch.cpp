@@ -0,0 +1,208 @@
+#include "TabuSearch.h"
+#include "HashSet.h"
+#include "Deadline.h"
+#include "Instance.h"
+#include "Neighborhood.h"
+#include "Profile.h"
+#include "Random.h"
+#include "Solution.h"
+#include "SolutionFactory.h"
+#include "Statistics.h"
+#include "TrajectoryEngine.h"
+#include "utils.h"
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+auto is_tabu_infinite(int tabu_size) -> bool {
+    return tabu_size <= 0;
+}
+
+// Tabu list of solution hashes with O(1) lookups. A bounded list evicts its
+// oldest entry through a ring buffer. Both grow with the entries rather than
+// the tabu size, which may be far larger than a run ever reaches.
+class TabuList {
+private:
+    int tabu_size;
+    HashSet hashes;
+    std::vector<std::uint64_t> ring;
+    int ring_head;
+
+public:
+    explicit TabuList(int tabu_size)
+        : tabu_size(tabu_size),
+          ring_head(0) {
+    }
+
+    auto contains(std::uint64_t hash) -> bool {
+        return this->hashes.contains(hash);
+    }
+
+    auto push(std::uint64_t hash) -> void {
+        if (is_tabu_infinite(this->tabu_size)) {
+            this->hashes.insert(hash);
+            return;
+        }
+
+        if ((int)this->ring.size() < this->tabu_size) {
+            this->ring.push_back(hash);
+        } else {
+            this->hashes.erase(this->ring[this->ring_head]);
+            this->ring[this->ring_head] = hash;
+            this->ring_head = (this->ring_head + 1) % this->tabu_size;
+        }
+
+        this->hashes.insert(hash);
+    }
+};
+
+// Step policy moving to the best neighbor that is not tabu. Every reached
+// solution becomes tabu; with backtracking, taken moves are undone in reverse
+// order once every neighbor is tabu.
+class TabuStep {
+private:
+    TabuList tabu;
+    bool backtracking;
+    // Inverse of every move taken so far.
+    std::vector<Move> previous_moves;
+
+public:
+    TabuStep(int tabu_size, bool backtracking)
+        : tabu(tabu_size),
+          backtracking(backtracking) {
+    }
+
+    auto make_tabu(Solution &solution) -> void {
+        this->tabu.push(solution.get_hash());
+    }
+
+    template <typename NeighborhoodT>
+    auto propose(Solution &solution, NeighborhoodT &neighborhood, Random &) -> Candidate {
+        auto best = Candidate{Move{0, 0}, NO_CANDIDATE_FILLED_BIN_COUNT};
+
+        neighborhood.for_each_move(solution, [&](Move move) {
+            if (this->tabu.contains(solution.hash_move(move))) {
+                profile_count(ProfileCounter::TABU_HITS);
+                return;
+            }
+
+            auto filled_bin_count = solution.evaluate_move(move);
+
+            if (filled_bin_count < best.filled_bin_count) {
+                best = Candidate{move, filled_bin_count};
+            }
+        });
+
+        return best;
+    }
+
+    auto on_apply(Solution &solution, const Move &move) -> void {
+        this->make_tabu(solution);
+        this->previous_moves.push_back(get_inverse_move(move));
+    }
+
+    auto on_exhausted(Solution &solution) -> bool {
+        if (!this->backtracking || this->previous_moves.empty()) {
+            return false;
+        }
+
+        solution.apply_move(this->previous_moves.back());
+        this->previous_moves.pop_back();
+
+        return true;
+    }
+};
+
+class TabuSearchSolutionFactory : public TrajectorySolutionFactory {
+public:
+    explicit TabuSearchSolutionFactory(InstancePtr instance)
+        : TrajectorySolutionFactory(std::move(instance)) {
+    }
+
+    auto generate_tabu_search_solution(int tabu_size, int iteration_count, bool backtracking = false) -> Solution {
+        auto current_solution = Solution{this->instance, this->start_genome};
+        auto best_solution = current_solution;
+        this->report_new_best(best_solution);
+
+        auto engine = make_trajectory_engine(
+            this->neighborhood,
+            TabuStep{tabu_size, backtracking},
+            AlwaysAcceptance{},
+            this->lower_bound);
+        engine.get_step().make_tabu(current_solution);
+
+        // Tabu search makes no random choice; the generator only fills the policies' signature.
+        auto rgen = Random{0};
+
+        // Every iteration scans a whole neighborhood, so the clock is read each time.
+        engine.run(
+            current_solution,
+            best_solution,
+            rgen,
+            iteration_count,
+            [&]() { return this->deadline.is_expired_now(); },
+            [&](Solution &solution) { this->report_new_best(solution); });
+
+        return best_solution;
+    }
+};
+
+static auto solve_with_tabu_search(
+    InstancePtr instance,
+    const std::vector<int> &args,
+    const Options &options,
+    const SolveBudget &budget,
+    NewBestCb new_best_cb)
+    -> SolveResult {
+    auto solution_factory = TabuSearchSolutionFactory{std::move(instance)};
+
+    auto statistics = RunStatistics{solution_factory.get_lower_bound()};
+    auto evaluation_scope = EvaluationCountScope{statistics.get_evaluation_counter()};
+    solution_factory.set_new_best_cb(make_new_best_cb(statistics, std::move(new_best_cb)));
+    solution_factory.set_deadline(Deadline{budget.time_limit_ms, budget.cancelled});
+    solution_factory.set_start(options.at("start"));
+    solution_factory.set_neighborhood(Neighborhood{
+        parse_neighborhood_type(options.at("neighborhood")),
+        get_int_option(options, "candidate-bins")});
+
+    auto tabu_size = args[0];
+    auto iteration_count = args[1];
+
+    auto solutions = std::vector<LabelledSolution>{};
+    solutions.push_back({
+        "Tabu search solution",
+        solution_factory.generate_tabu_search_solution(tabu_size, iteration_count),
+    });
+    solutions.push_back({
+        "Tabu search with backtracking solution",
+        solution_factory.generate_tabu_search_solution(tabu_size, iteration_count, true),
+    });
+
+    statistics.finish();
+
+    return SolveResult{std::move(solutions), statistics, 0};
+}
+
+auto get_tabu_search_spec() -> AlgorithmSpec {
+    return AlgorithmSpec{
+        {
+            {
+                "Size of tabu",
+                "Tabu not greater than 0 means infinite tabu",
+                {},
+                -1,
+            },
+            {
+                "Iteration count",
+                "",
+                {},
+                1000,
+                0,
+            },
+        },
+        get_trajectory_solver_options(),
+        false,
+        solve_with_tabu_search,
+    };
+}
@@ -0,0 +1,9 @@
+#include "Solver.h"
+
+#ifndef TABU_SEARCH_H
+#define TABU_SEARCH_H
+
+// Spec of the "tabu-search" algorithm of solve().
+auto get_tabu_search_spec() -> AlgorithmSpec;
+
+#endif // TABU_SEARCH_H
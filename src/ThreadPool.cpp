@@ -0,0 +1,93 @@
+#include "ThreadPool.h"
+#include <algorithm>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+auto resolve_thread_count(int thread_count) -> int {
+    if (thread_count > 0) {
+        return thread_count;
+    }
+
+    return std::max(1, (int)std::thread::hardware_concurrency());
+}
+
+ThreadPool::ThreadPool(int thread_count)
+    : pending_task_count(0),
+      stopping(false) {
+    for (auto i = 0; i < resolve_thread_count(thread_count); i++) {
+        this->workers.emplace_back([this]() { this->work(); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        auto lock = std::unique_lock<std::mutex>{this->mutex};
+        this->stopping = true;
+    }
+
+    this->task_available.notify_all();
+
+    for (auto &worker : this->workers) {
+        worker.join();
+    }
+}
+
+auto ThreadPool::work() -> void {
+    while (true) {
+        auto task = std::function<void()>{};
+
+        {
+            auto lock = std::unique_lock<std::mutex>{this->mutex};
+            this->task_available.wait(lock, [this]() {
+                return this->stopping || !this->tasks.empty();
+            });
+
+            if (this->tasks.empty()) {
+                return;
+            }
+
+            task = std::move(this->tasks.front());
+            this->tasks.pop_front();
+        }
+
+        task();
+
+        {
+            auto lock = std::unique_lock<std::mutex>{this->mutex};
+            if (--this->pending_task_count == 0) {
+                this->tasks_done.notify_all();
+            }
+        }
+    }
+}
+
+auto ThreadPool::run_chunks(int chunk_count, const std::function<void(int)> &chunk_cb) -> void {
+    {
+        auto lock = std::unique_lock<std::mutex>{this->mutex};
+
+        for (auto i = 0; i < chunk_count; i++) {
+            this->tasks.push_back([&chunk_cb, i]() { chunk_cb(i); });
+        }
+
+        this->pending_task_count += chunk_count;
+    }
+
+    this->task_available.notify_all();
+
+    auto lock = std::unique_lock<std::mutex>{this->mutex};
+    this->tasks_done.wait(lock, [this]() {
+        return this->pending_task_count == 0;
+    });
+}
+
+auto ThreadPool::submit(std::function<void()> task) -> void {
+    {
+        auto lock = std::unique_lock<std::mutex>{this->mutex};
+        this->tasks.push_back(std::move(task));
+        this->pending_task_count++;
+    }
+
+    this->task_available.notify_one();
+}
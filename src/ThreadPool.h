@@ -0,0 +1,44 @@
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+// Fixed set of worker threads running chunks of a parallel loop.
+class ThreadPool {
+private:
+    std::vector<std::thread> workers;
+    std::deque<std::function<void()>> tasks;
+    std::mutex mutex;
+    std::condition_variable task_available;
+    std::condition_variable tasks_done;
+    int pending_task_count;
+    bool stopping;
+
+    auto work() -> void;
+
+public:
+    // Thread count not greater than 0 means one thread per hardware thread.
+    explicit ThreadPool(int thread_count);
+
+    ~ThreadPool();
+
+    inline auto get_thread_count() -> int {
+        return this->workers.size();
+    }
+
+    // Runs `chunk_cb(chunk_index)` for every chunk and waits for all of them.
+    auto run_chunks(int chunk_count, const std::function<void(int)> &chunk_cb) -> void;
+
+    // Queues a task without waiting for it; tasks start in submission order.
+    // Not to be mixed with run_chunks(), which waits for every pending task.
+    auto submit(std::function<void()> task) -> void;
+};
+
+auto resolve_thread_count(int thread_count) -> int;
+
+#endif // THREAD_POOL_H
@@ -0,0 +1,235 @@
+#include "Move.h"
+#include "Random.h"
+#include "Solution.h"
+#include <cmath>
+#include <limits>
+#include <utility>
+#include <variant>
+
+#ifndef TRAJECTORY_ENGINE_H
+#define TRAJECTORY_ENGINE_H
+
+// Shared loop of the trajectory solvers. A solver is a TrajectoryEngine
+// instantiated with a step policy choosing the next move, an acceptance policy
+// deciding whether to take it and, for simulated annealing, a cooling schedule.
+// Every policy is a plain type, so the loop compiles into one function per
+// configuration with no indirect call per iteration.
+
+// Move proposed by a step; NO_CANDIDATE_FILLED_BIN_COUNT when there is none.
+struct Candidate {
+    Move move;
+    int filled_bin_count;
+};
+
+const auto NO_CANDIDATE_FILLED_BIN_COUNT = std::numeric_limits<int>::max();
+
+// Step policies provide:
+//   propose(solution, neighborhood, rgen) -> Candidate
+//   on_apply(solution, move), called after the candidate's move was applied
+//   on_exhausted(solution) -> bool, called when there is no candidate; false ends the search
+
+// One random neighbor.
+struct RandomMoveStep {
+    template <typename NeighborhoodT>
+    inline auto propose(Solution &solution, NeighborhoodT &neighborhood, Random &rgen) -> Candidate {
+        auto move = neighborhood.generate_random_move(solution, rgen);
+        return Candidate{move, solution.evaluate_move(move)};
+    }
+
+    inline auto on_apply(Solution &, const Move &) -> void {
+    }
+
+    inline auto on_exhausted(Solution &) -> bool {
+        return false;
+    }
+};
+
+// Best neighbor of a full scan; the first one wins ties.
+struct BestNeighborStep {
+    template <typename NeighborhoodT>
+    inline auto propose(Solution &solution, NeighborhoodT &neighborhood, Random &) -> Candidate {
+        auto best = Candidate{Move{0, 0}, NO_CANDIDATE_FILLED_BIN_COUNT};
+
+        neighborhood.for_each_move(solution, [&](Move move) {
+            auto filled_bin_count = solution.evaluate_move(move);
+
+            if (filled_bin_count < best.filled_bin_count) {
+                best = Candidate{move, filled_bin_count};
+            }
+        });
+
+        return best;
+    }
+
+    inline auto on_apply(Solution &, const Move &) -> void {
+    }
+
+    inline auto on_exhausted(Solution &) -> bool {
+        return false;
+    }
+};
+
+// Cooling schedules map the iteration index to a temperature.
+
+// T = 1 / k
+struct InverseCooling {
+    inline auto get_temperature(int iteration) const -> double {
+        return 1.0 / iteration;
+    }
+};
+
+// T = 1 / log10(k)
+struct LogarithmicCooling {
+    inline auto get_temperature(int iteration) const -> double {
+        return 1.0 / std::log10(iteration);
+    }
+};
+
+// T = 0.5^k
+struct ExponentialCooling {
+    inline auto get_temperature(int iteration) const -> double {
+        return std::pow(0.5, iteration);
+    }
+};
+
+// Fixed temperature, used by the chains of replica exchange.
+struct ConstantCooling {
+    double temperature;
+
+    inline auto get_temperature(int) const -> double {
+        return this->temperature;
+    }
+};
+
+// Runtime choice of schedule, resolved once with std::visit.
+using CoolingSchedule = std::variant<InverseCooling, LogarithmicCooling, ExponentialCooling, ConstantCooling>;
+
+// Acceptance policies provide accepts(current, candidate, iteration, rgen) and
+// STOPS_ON_REJECTION, which ends the search at the first rejected candidate.
+
+// Strictly better candidates only.
+struct ImprovingAcceptance {
+    static constexpr auto STOPS_ON_REJECTION = true;
+
+    inline auto accepts(int filled_bin_count, int candidate_filled_bin_count, int, Random &) -> bool {
+        return candidate_filled_bin_count < filled_bin_count;
+    }
+};
+
+// Candidates no worse than the current solution.
+struct NonWorseningAcceptance {
+    static constexpr auto STOPS_ON_REJECTION = true;
+
+    inline auto accepts(int filled_bin_count, int candidate_filled_bin_count, int, Random &) -> bool {
+        return candidate_filled_bin_count <= filled_bin_count;
+    }
+};
+
+// Every candidate, as tabu search moves to its best non-tabu neighbor even when it is worse.
+struct AlwaysAcceptance {
+    static constexpr auto STOPS_ON_REJECTION = false;
+
+    inline auto accepts(int, int, int, Random &) -> bool {
+        return true;
+    }
+};
+
+// Metropolis criterion: worse candidates are taken with probability exp(-delta / T).
+template <typename Cooling>
+struct MetropolisAcceptance {
+    static constexpr auto STOPS_ON_REJECTION = false;
+
+    Cooling cooling;
+
+    inline auto accepts(int filled_bin_count, int candidate_filled_bin_count, int iteration, Random &rgen) -> bool {
+        auto delta = candidate_filled_bin_count - filled_bin_count;
+
+        return delta <= 0 ||
+               rgen.next_double() < std::exp(-delta / this->cooling.get_temperature(iteration));
+    }
+};
+
+template <typename NeighborhoodT, typename Step, typename Acceptance>
+class TrajectoryEngine {
+private:
+    NeighborhoodT neighborhood;
+    Step step;
+    Acceptance acceptance;
+    int lower_bound;
+
+public:
+    TrajectoryEngine(NeighborhoodT neighborhood, Step step, Acceptance acceptance, int lower_bound)
+        : neighborhood(std::move(neighborhood)),
+          step(std::move(step)),
+          acceptance(std::move(acceptance)),
+          lower_bound(lower_bound) {
+    }
+
+    auto get_step() -> Step & {
+        return this->step;
+    }
+
+    // Moves `solution` for up to `iteration_count` steps, copying it to
+    // `best_solution` and calling `on_new_best(best_solution)` whenever it beats
+    // it. Passing the same solution twice skips the copies, for searches that
+    // only accept improvements. Stops early at the lower bound, when the step or
+    // the acceptance ends the search, or when `should_stop()` is true.
+    template <typename ShouldStop, typename OnNewBest>
+    auto run(
+        Solution &solution,
+        Solution &best_solution,
+        Random &rgen,
+        int iteration_count,
+        ShouldStop &&should_stop,
+        OnNewBest &&on_new_best)
+        -> void {
+        for (auto i = 0;
+             i < iteration_count &&
+             best_solution.get_filled_bin_count() > this->lower_bound &&
+             !should_stop();
+             i++) {
+            auto candidate = this->step.propose(solution, this->neighborhood, rgen);
+
+            if (candidate.filled_bin_count == NO_CANDIDATE_FILLED_BIN_COUNT) {
+                if (!this->step.on_exhausted(solution)) {
+                    return;
+                }
+
+                continue;
+            }
+
+            if (!this->acceptance.accepts(solution.get_filled_bin_count(), candidate.filled_bin_count, i, rgen)) {
+                if (Acceptance::STOPS_ON_REJECTION) {
+                    return;
+                }
+
+                continue;
+            }
+
+            auto improved = candidate.filled_bin_count < best_solution.get_filled_bin_count();
+
+            solution.apply_move(candidate.move);
+            this->step.on_apply(solution, candidate.move);
+
+            if (improved) {
+                if (&best_solution != &solution) {
+                    best_solution = solution;
+                }
+
+                on_new_best(best_solution);
+            }
+        }
+    }
+};
+
+template <typename NeighborhoodT, typename Step, typename Acceptance>
+auto make_trajectory_engine(NeighborhoodT neighborhood, Step step, Acceptance acceptance, int lower_bound)
+    -> TrajectoryEngine<NeighborhoodT, Step, Acceptance> {
+    return TrajectoryEngine<NeighborhoodT, Step, Acceptance>{
+        std::move(neighborhood),
+        std::move(step),
+        std::move(acceptance),
+        lower_bound};
+}
+
+#endif // TRAJECTORY_ENGINE_H
@@ -0,0 +1,127 @@
+#include "WorkStealingPool.h"
+#include "ThreadPool.h"
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+// Pool and deque index of the worker running on the current thread.
+thread_local WorkStealingPool *_current_pool = nullptr;
+thread_local int _current_worker_index = -1;
+
+WorkStealingPool::WorkStealingPool(int thread_count)
+    : queued_task_count(0),
+      pending_task_count(0),
+      next_queue_index(0),
+      stopping(false) {
+    auto resolved_thread_count = resolve_thread_count(thread_count);
+
+    for (auto i = 0; i < resolved_thread_count; i++) {
+        this->queues.push_back(std::make_unique<WorkerQueue>());
+    }
+
+    for (auto i = 0; i < resolved_thread_count; i++) {
+        this->workers.emplace_back([this, i]() { this->work(i); });
+    }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    {
+        auto lock = std::unique_lock<std::mutex>{this->mutex};
+        this->stopping = true;
+    }
+
+    this->task_available.notify_all();
+
+    for (auto &worker : this->workers) {
+        worker.join();
+    }
+}
+
+auto WorkStealingPool::pop_task(int worker_index, std::function<void()> &task) -> bool {
+    auto queue_count = (int)this->queues.size();
+
+    for (auto i = 0; i < queue_count; i++) {
+        auto &queue = *this->queues[(worker_index + i) % queue_count];
+        auto lock = std::unique_lock<std::mutex>{queue.mutex};
+
+        if (queue.tasks.empty()) {
+            continue;
+        }
+
+        if (i == 0) {
+            task = std::move(queue.tasks.back());
+            queue.tasks.pop_back();
+        } else {
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+        }
+
+        return true;
+    }
+
+    return false;
+}
+
+auto WorkStealingPool::work(int worker_index) -> void {
+    _current_pool = this;
+    _current_worker_index = worker_index;
+
+    while (true) {
+        auto task = std::function<void()>{};
+
+        if (this->pop_task(worker_index, task)) {
+            {
+                auto lock = std::unique_lock<std::mutex>{this->mutex};
+                this->queued_task_count--;
+            }
+
+            task();
+
+            auto lock = std::unique_lock<std::mutex>{this->mutex};
+            if (--this->pending_task_count == 0) {
+                this->tasks_done.notify_all();
+            }
+
+            continue;
+        }
+
+        auto lock = std::unique_lock<std::mutex>{this->mutex};
+        this->task_available.wait(lock, [this]() {
+            return this->stopping || this->queued_task_count > 0;
+        });
+
+        if (this->stopping && this->queued_task_count == 0) {
+            return;
+        }
+    }
+}
+
+auto WorkStealingPool::submit(std::function<void()> task) -> void {
+    auto queue_index = _current_pool == this ? _current_worker_index : -1;
+
+    {
+        auto lock = std::unique_lock<std::mutex>{this->mutex};
+
+        if (queue_index < 0) {
+            queue_index = this->next_queue_index;
+            this->next_queue_index = (this->next_queue_index + 1) % this->queues.size();
+        }
+
+        this->pending_task_count++;
+        this->queued_task_count++;
+
+        auto &queue = *this->queues[queue_index];
+        auto queue_lock = std::unique_lock<std::mutex>{queue.mutex};
+        queue.tasks.push_back(std::move(task));
+    }
+
+    this->task_available.notify_one();
+}
+
+auto WorkStealingPool::wait() -> void {
+    auto lock = std::unique_lock<std::mutex>{this->mutex};
+    this->tasks_done.wait(lock, [this]() {
+        return this->pending_task_count == 0;
+    });
+}
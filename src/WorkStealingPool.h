@@ -0,0 +1,54 @@
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#ifndef WORK_STEALING_POOL_H
+#define WORK_STEALING_POOL_H
+
+// Worker threads with a task deque each. A worker runs its own newest task and,
+// once its deque is empty, steals the oldest task of another worker, so tasks of
+// very different lengths still keep every thread busy.
+class WorkStealingPool {
+private:
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues;
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable task_available;
+    std::condition_variable tasks_done;
+    int queued_task_count;
+    int pending_task_count;
+    int next_queue_index;
+    bool stopping;
+
+    auto pop_task(int worker_index, std::function<void()> &task) -> bool;
+
+    auto work(int worker_index) -> void;
+
+public:
+    // Thread count not greater than 0 means one thread per hardware thread.
+    explicit WorkStealingPool(int thread_count);
+
+    ~WorkStealingPool();
+
+    inline auto get_thread_count() -> int {
+        return this->workers.size();
+    }
+
+    // Queues a task; called from a worker, it goes to that worker's own deque,
+    // otherwise the deques take turns.
+    auto submit(std::function<void()> task) -> void;
+
+    // Waits until every submitted task, including ones submitted by tasks, has finished.
+    auto wait() -> void;
+};
+
+#endif // WORK_STEALING_POOL_H
@@ -0,0 +1,347 @@
+#include "../Instance.h"
+#include "../utils.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vector>
+
+using InstanceGeneratorCb = std::function<std::vector<int>(int, std::mt19937 &)>;
+
+struct InstanceClass {
+    int bin_weight_limit;
+    InstanceGeneratorCb generate_weights;
+};
+
+auto generate_uniform_weights(int min_weight, int max_weight, int item_count, std::mt19937 &rgen) -> std::vector<int> {
+    auto distr = std::uniform_int_distribution<int>{min_weight, max_weight};
+
+    auto weights = std::vector<int>{};
+    weights.reserve(item_count);
+
+    for (auto i = 0; i < item_count; i++) {
+        weights.push_back(distr(rgen));
+    }
+
+    return weights;
+}
+
+// Falkenauer's triplet class: every consecutive triplet fills a bin of 1000
+// exactly, so the optimum is item_count / 3 bins. Shuffled afterwards; the item
+// count is rounded down to a multiple of 3.
+auto generate_triplet_weights(int item_count, std::mt19937 &rgen) -> std::vector<int> {
+    auto weights = std::vector<int>{};
+    weights.reserve(item_count);
+
+    for (auto i = 0; i < item_count / 3; i++) {
+        auto first = std::uniform_int_distribution<int>{380, 490}(rgen);
+        auto second = std::uniform_int_distribution<int>{250, (1000 - first) / 2}(rgen);
+
+        weights.push_back(first);
+        weights.push_back(second);
+        weights.push_back(1000 - first - second);
+    }
+
+    std::shuffle(weights.begin(), weights.end(), rgen);
+
+    return weights;
+}
+
+auto INSTANCE_CLASS_MAP = std::map<std::string, InstanceClass>{
+    {
+        "uniform",
+        {
+            100,
+            [](int item_count, std::mt19937 &rgen) {
+                return generate_uniform_weights(1, 100, item_count, rgen);
+            },
+        },
+    },
+    {
+        "falkenauer",
+        {
+            150,
+            [](int item_count, std::mt19937 &rgen) {
+                return generate_uniform_weights(20, 100, item_count, rgen);
+            },
+        },
+    },
+    {
+        "triplet",
+        {
+            1000,
+            generate_triplet_weights,
+        },
+    },
+};
+
+using AlgorithmArgsCb = std::function<std::vector<std::string>(int)>;
+
+struct BenchmarkedAlgorithm {
+    // Larger instances are skipped; the algorithm cannot finish them in a reasonable time.
+    int max_item_count;
+    AlgorithmArgsCb get_args;
+};
+
+auto clamp_budget(double budget, int min_value, int max_value) -> std::string {
+    return std::to_string(std::clamp((int)budget, min_value, max_value));
+}
+
+auto ALGORITHM_MAP = std::map<std::string, BenchmarkedAlgorithm>{
+    {
+        "hill-climbing",
+        {
+            10000,
+            [](int) { return std::vector<std::string>{}; },
+        },
+    },
+    {
+        "tabu-search",
+        {
+            100000,
+            [](int item_count) {
+                return std::vector<std::string>{"50", clamp_budget(2e6 / item_count, 1, 1000)};
+            },
+        },
+    },
+    {
+        "simulated-annealing",
+        {
+            1000000,
+            [](int item_count) {
+                return std::vector<std::string>{clamp_budget(2e7 / item_count, 100, 100000), "1"};
+            },
+        },
+    },
+    {
+        "genetic-algorithm",
+        {
+            1000,
+            [](int) {
+                return std::vector<std::string>{"50", "1", "1", "1", "1"};
+            },
+        },
+    },
+};
+
+auto split_list(const std::string &list) -> std::vector<std::string> {
+    auto items = std::vector<std::string>{};
+    auto stream = std::stringstream{list};
+
+    auto item = std::string{};
+    while (std::getline(stream, item, ',')) {
+        if (item.size()) {
+            items.push_back(item);
+        }
+    }
+
+    return items;
+}
+
+struct RunResult {
+    std::map<std::string, std::string> statistics;
+    long peak_rss_kb;
+};
+
+// Runs the solver binary in a child process, so its peak RSS is measured in isolation.
+auto run_solver(const std::string &binary, const std::vector<std::string> &args) -> RunResult {
+    int output_pipe[2];
+    if (pipe(output_pipe) < 0) {
+        throw std::runtime_error{"Cannot create pipe"};
+    }
+
+    auto pid = fork();
+
+    if (pid == 0) {
+        dup2(output_pipe[1], STDOUT_FILENO);
+        close(output_pipe[0]);
+        close(output_pipe[1]);
+
+        auto argv = std::vector<char *>{const_cast<char *>(binary.c_str())};
+        for (auto &arg : args) {
+            argv.push_back(const_cast<char *>(arg.c_str()));
+        }
+        argv.push_back(nullptr);
+
+        execv(binary.c_str(), argv.data());
+        std::_Exit(127);
+    }
+
+    close(output_pipe[1]);
+
+    auto output = std::string{};
+    char buffer[4096];
+    ssize_t read_size;
+    while ((read_size = read(output_pipe[0], buffer, sizeof(buffer))) > 0) {
+        output.append(buffer, read_size);
+    }
+    close(output_pipe[0]);
+
+    int status;
+    struct rusage usage;
+    wait4(pid, &status, 0, &usage);
+
+    auto result = RunResult{{}, usage.ru_maxrss};
+
+    auto statistics_position = output.rfind("Statistics:");
+    if (!WIFEXITED(status) || WEXITSTATUS(status) || statistics_position == std::string::npos) {
+        throw std::runtime_error{"Solver run failed: " + binary};
+    }
+
+    auto stream = std::stringstream{output.substr(statistics_position + 11)};
+    auto pair = std::string{};
+    while (stream >> pair) {
+        auto separator = pair.find('=');
+        result.statistics[pair.substr(0, separator)] = pair.substr(separator + 1);
+    }
+
+    return result;
+}
+
+// Writes a CSV row for every run; instance files are saved to and removed from `instance_directory`.
+static auto run_benchmarks(
+    Options &options,
+    const std::string &binary_directory,
+    const std::string &instance_directory,
+    std::ostream &output)
+    -> void {
+    output
+        << "class,size,seed,algorithm,lower_bound,final_bins,gap,evaluations,elapsed_ms,"
+           "evaluations_per_second,ns_per_evaluation,peak_rss_kb,time_to_best_ms"
+        << std::endl;
+
+    for (auto &seed : split_list(options["seeds"])) {
+        for (auto &class_name : split_list(options["classes"])) {
+            auto &instance_class = INSTANCE_CLASS_MAP.at(class_name);
+
+            for (auto &size : split_list(options["sizes"])) {
+                auto item_count = std::stoi(size);
+
+                auto seed_sequence = std::seed_seq{std::stoi(seed), item_count};
+                auto rgen = std::mt19937{seed_sequence};
+                auto instance = Instance{
+                    instance_class.bin_weight_limit,
+                    instance_class.generate_weights(item_count, rgen)};
+
+                auto instance_path = instance_directory + "/" + class_name + "-" + size + "-" + seed + ".bin";
+                save_binary_instance(instance_path, instance);
+
+                for (auto &algorithm_name : split_list(options["algorithms"])) {
+                    auto &algorithm = ALGORITHM_MAP.at(algorithm_name);
+
+                    if (item_count > algorithm.max_item_count) {
+                        continue;
+                    }
+
+                    auto args = std::vector<std::string>{"--data", instance_path, "--statistics", "1", "--seed", seed};
+                    for (auto &arg : algorithm.get_args(item_count)) {
+                        args.push_back(arg);
+                    }
+
+                    auto result = run_solver(binary_directory + algorithm_name, args);
+
+                    auto evaluations = std::stod(result.statistics["evaluations"]);
+                    auto elapsed_ms = std::stod(result.statistics["elapsed_ms"]);
+                    auto final_bins = std::stoll(result.statistics["best_bins"]);
+                    auto lower_bound = std::stoll(result.statistics["lower_bound"]);
+
+                    output
+                        << class_name << ","
+                        << instance.get_item_count() << ","
+                        << seed << ","
+                        << algorithm_name << ","
+                        << lower_bound << ","
+                        << final_bins << ","
+                        << final_bins - lower_bound << ","
+                        << (long long)evaluations << ","
+                        << elapsed_ms << ","
+                        << (elapsed_ms > 0 ? evaluations * 1000 / elapsed_ms : 0) << ","
+                        << (evaluations > 0 ? elapsed_ms * 1e6 / evaluations : 0) << ","
+                        << result.peak_rss_kb << ","
+                        << result.statistics["time_to_best_ms"]
+                        << std::endl;
+                }
+
+                std::remove(instance_path.c_str());
+            }
+        }
+    }
+}
+
+int main(int argc, char *argv[]) {
+    auto options = collect_options(
+        {
+            {
+                "sizes",
+                "Comma separated instance sizes",
+                "100,1000,10000,100000,1000000",
+            },
+            {
+                "classes",
+                "Comma separated instance classes: uniform, falkenauer, triplet",
+                "uniform,falkenauer,triplet",
+            },
+            {
+                "algorithms",
+                "Comma separated algorithms",
+                "hill-climbing,tabu-search,simulated-annealing,genetic-algorithm",
+            },
+            {
+                "seeds",
+                "Comma separated seeds; each one generates its own instances and seeds the solvers",
+                "1",
+            },
+            {
+                "output",
+                "CSV output file; - means stdout",
+                "-",
+            },
+        },
+        argc,
+        argv);
+
+    if (argc >= 2) {
+        std::cout
+            << "No args allowed!"
+            << std::endl;
+
+        return 0;
+    }
+
+    auto binary_directory = std::string{argv[0]};
+    binary_directory = binary_directory.substr(0, binary_directory.rfind('/') + 1);
+
+    char instance_directory_template[] = "/tmp/mhe-benchmark-XXXXXX";
+    auto instance_directory = std::string{mkdtemp(instance_directory_template)};
+
+    auto output_file = std::ofstream{};
+    if (options["output"] != "-") {
+        output_file.open(options["output"]);
+    }
+    auto &output = options["output"] != "-" ? output_file : std::cout;
+
+    try {
+        run_benchmarks(options, binary_directory, instance_directory, output);
+    } catch (const std::exception &error) {
+        // A failed run leaves its instance file behind.
+        std::filesystem::remove_all(instance_directory);
+        std::cerr << "Error: " << error.what() << std::endl;
+        return 1;
+    }
+
+    rmdir(instance_directory.c_str());
+
+    return 0;
+}
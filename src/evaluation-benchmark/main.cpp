@@ -0,0 +1,133 @@
+#include "../BatchEvaluation.h"
+#include "../Instance.h"
+#include "../Solution.h"
+#include "../utils.h"
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+const auto BIN_WEIGHT_LIMIT = 100;
+const auto MIN_MEASUREMENT_DURATION = std::chrono::milliseconds{300};
+// Genomes scored by every batch evaluation.
+const auto BATCH_SIZE = 16;
+
+auto _bench_rgen = std::mt19937{2022};
+
+auto generate_garbage_bags(int bag_count) -> GarbageBags {
+    auto distr = std::uniform_int_distribution<int>{1, BIN_WEIGHT_LIMIT};
+
+    auto bags = GarbageBags{};
+    bags.reserve(bag_count);
+
+    for (auto i = 0; i < bag_count; i++) {
+        bags.push_back(GarbageBag{distr(_bench_rgen)});
+    }
+
+    return bags;
+}
+
+// Repeats `evaluate` until the measurement lasts long enough and returns evaluations per second.
+auto measure_evaluations_per_second(std::function<int()> evaluate) -> double {
+    auto evaluation_count = 0LL;
+    auto checksum = 0LL;
+
+    auto start = std::chrono::steady_clock::now();
+    auto elapsed = std::chrono::steady_clock::duration{};
+
+    do {
+        checksum += evaluate();
+        evaluation_count++;
+        elapsed = std::chrono::steady_clock::now() - start;
+    } while (elapsed < MIN_MEASUREMENT_DURATION);
+
+    if (checksum < 0) {
+        std::cout << checksum << std::endl;
+    }
+
+    return evaluation_count / std::chrono::duration<double>{elapsed}.count();
+}
+
+int main(int argc, char *[]) {
+    if (argc >= 2) {
+        std::cout
+            << "No args allowed!"
+            << std::endl;
+
+        return 0;
+    }
+
+    std::cout
+        << "SIMD batch kernel: " << get_batch_kernel_name(get_best_batch_kernel())
+        << std::endl
+        << std::setw(10) << "Bags"
+        << std::setw(20) << "get_bins() eval/s"
+        << std::setw(20) << "count eval/s"
+        << std::setw(20) << "swap delta eval/s"
+        << std::setw(20) << "scalar batch eval/s"
+        << std::setw(20) << "simd batch eval/s"
+        << std::endl;
+
+    for (auto bag_count : {10000, 100000, 1000000}) {
+        auto solution = Solution{std::make_shared<const Instance>(
+            BIN_WEIGHT_LIMIT,
+            generate_garbage_bags(bag_count))};
+        auto index_distr = std::uniform_int_distribution<int>{0, bag_count - 2};
+
+        auto bins_eval_per_second = measure_evaluations_per_second([&]() {
+            return (int)solution.get_bins().size();
+        });
+
+        auto count_eval_per_second = measure_evaluations_per_second([&]() {
+            return solution.count_filled_bins();
+        });
+
+        auto delta_eval_per_second = measure_evaluations_per_second([&]() {
+            auto index = index_distr(_bench_rgen);
+            return solution.evaluate_swap(index, index + 1);
+        });
+
+        auto genomes = std::vector<Genome>{};
+        auto genome_pointers = std::vector<const Genome *>{};
+        for (auto i = 0; i < BATCH_SIZE; i++) {
+            auto items = range(bag_count);
+            std::shuffle(items.begin(), items.end(), _bench_rgen);
+            genomes.emplace_back(items);
+        }
+        for (auto &genome : genomes) {
+            genome_pointers.push_back(&genome);
+        }
+
+        auto filled_bin_counts = std::vector<int>(BATCH_SIZE);
+        auto measure_batch_evaluations_per_second = [&](BatchKernel kernel) {
+            return BATCH_SIZE * measure_evaluations_per_second([&]() {
+                count_filled_bins_batch(
+                    *solution.get_instance(),
+                    genome_pointers.data(),
+                    BATCH_SIZE,
+                    filled_bin_counts.data(),
+                    kernel);
+                return filled_bin_counts[0];
+            });
+        };
+
+        auto scalar_batch_eval_per_second = measure_batch_evaluations_per_second(BatchKernel::SCALAR);
+        auto simd_batch_eval_per_second = measure_batch_evaluations_per_second(get_best_batch_kernel());
+
+        std::cout
+            << std::fixed << std::setprecision(0)
+            << std::setw(10) << bag_count
+            << std::setw(20) << bins_eval_per_second
+            << std::setw(20) << count_eval_per_second
+            << std::setw(20) << delta_eval_per_second
+            << std::setw(20) << scalar_batch_eval_per_second
+            << std::setw(20) << simd_batch_eval_per_second
+            << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,34 @@
+#include "../Instance.h"
+#include "../utils.h"
+#include <iostream>
+#include <vector>
+
+int main(int argc, char *argv[]) {
+    auto expected_options = get_instance_options();
+    expected_options.push_back({
+        "output",
+        "Binary instance file to write",
+        "./data.bin",
+    });
+
+    auto options = collect_options(expected_options, argc, argv);
+
+    if (argc >= 2) {
+        std::cout
+            << "No args allowed!"
+            << std::endl;
+
+        return 0;
+    }
+
+    auto instance = load_instance(options);
+    save_binary_instance(options["output"], *instance);
+
+    std::cout
+        << "Wrote " << instance->get_item_count() << " bags"
+        << " (bin weight limit: " << instance->get_bin_weight_limit() << ")"
+        << " to " << options["output"]
+        << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,533 @@
+#include "../Instance.h"
+#include "../Json.h"
+#include "../Solution.h"
+#include "../Solver.h"
+#include "../ThreadPool.h"
+#include "../utils.h"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstdint>
+#include <exception>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <thread>
+#include <unistd.h>
+#include <utility>
+#include <vector>
+
+// Indexes of the thread, chain and island count args, which start threads of
+// their own for every request.
+const auto THREAD_COUNT_ARG_INDEXES = std::map<std::string, std::vector<int>>{
+    {"genetic-algorithm", {4, 5}},
+    {"hill-climbing", {1}},
+    {"simulated-annealing", {2}},
+};
+
+// Indexes of the population and tabu size args, whose memory grows with their value.
+const auto POPULATION_SIZE_ARG_INDEXES = std::map<std::string, int>{
+    {"genetic-algorithm", 0},
+};
+
+const auto TABU_SIZE_ARG_INDEXES = std::map<std::string, int>{
+    {"tabu-search", 0},
+};
+
+// Largest values of the args of one request, as every request holds a worker
+// and memory for as long as it runs.
+struct RequestLimits {
+    int thread_count;
+    int population_size;
+    int tabu_size;
+};
+
+// Output side of a client, stdout or a socket; every response is written as one whole line.
+class Connection {
+private:
+    int fd;
+    bool owns_fd;
+    std::mutex mutex;
+
+public:
+    Connection(int fd, bool owns_fd)
+        : fd(fd),
+          owns_fd(owns_fd) {
+    }
+
+    ~Connection() {
+        if (this->owns_fd) {
+            close(this->fd);
+        }
+    }
+
+    // Lines to a client that has gone away are dropped.
+    auto send_line(const std::string &line) -> void {
+        auto lock = std::lock_guard<std::mutex>{this->mutex};
+        auto data = line + "\n";
+
+        for (std::size_t written = 0; written < data.size();) {
+            auto count = write(this->fd, data.data() + written, data.size() - written);
+
+            if (count < 0 && errno == EINTR) {
+                continue;
+            }
+
+            if (count <= 0) {
+                return;
+            }
+
+            written += count;
+        }
+    }
+};
+
+using ConnectionPtr = std::shared_ptr<Connection>;
+
+struct Job {
+    std::string id;
+    std::string algorithm;
+    InstancePtr instance;
+    SolveParams params;
+    // Counted from `received_at`, so time spent queued is part of it.
+    int time_limit_ms;
+    std::chrono::steady_clock::time_point received_at;
+    std::atomic<bool> cancelled;
+    ConnectionPtr connection;
+};
+
+using JobPtr = std::shared_ptr<Job>;
+
+static auto get_elapsed_ms(std::chrono::steady_clock::time_point since) -> double {
+    return std::chrono::duration<double, std::milli>{std::chrono::steady_clock::now() - since}.count();
+}
+
+// Calls `line_cb` with every line read from `fd` until end of input.
+template <typename LineCb>
+static auto read_lines(int fd, LineCb line_cb) -> void {
+    auto buffer = std::string{};
+    char chunk[65536];
+
+    while (true) {
+        auto count = read(fd, chunk, sizeof(chunk));
+
+        if (count < 0 && errno == EINTR) {
+            continue;
+        }
+
+        if (count <= 0) {
+            break;
+        }
+
+        buffer.append(chunk, count);
+
+        auto line_start = std::size_t{0};
+        for (auto line_end = buffer.find('\n'); line_end != std::string::npos; line_end = buffer.find('\n', line_start)) {
+            line_cb(buffer.substr(line_start, line_end - line_start));
+            line_start = line_end + 1;
+        }
+
+        buffer.erase(0, line_start);
+    }
+
+    if (!buffer.empty()) {
+        line_cb(buffer);
+    }
+}
+
+// Solves JSON-lines requests on a warm worker pool; see the README for the protocol.
+class SolverServer {
+private:
+    std::mutex mutex;
+    // Queued and running jobs.
+    std::map<std::string, JobPtr> jobs;
+    std::uint64_t next_job_number;
+    std::atomic<int> queued_job_count;
+    std::atomic<int> running_job_count;
+    std::atomic<std::uint64_t> completed_job_count;
+    std::atomic<std::uint64_t> cancelled_job_count;
+    std::atomic<std::uint64_t> expired_job_count;
+    std::atomic<std::uint64_t> failed_job_count;
+    RequestLimits limits;
+    // Last, so it is destroyed first: its destructor runs the queued jobs, which use the members above.
+    ThreadPool workers;
+
+    auto get_metrics_json() -> std::string {
+        return "{\"queued\": " + std::to_string(this->queued_job_count.load()) +
+               ", \"running\": " + std::to_string(this->running_job_count.load()) +
+               ", \"workers\": " + std::to_string(this->workers.get_thread_count()) +
+               ", \"completed\": " + std::to_string(this->completed_job_count.load()) +
+               ", \"cancelled\": " + std::to_string(this->cancelled_job_count.load()) +
+               ", \"expired\": " + std::to_string(this->expired_job_count.load()) +
+               ", \"failed\": " + std::to_string(this->failed_job_count.load()) + "}";
+    }
+
+    static auto get_error_json(const std::string &id, const std::string &error) -> std::string {
+        return "{\"id\": " + quote_json(id) + ", \"status\": \"error\", \"error\": " + quote_json(error) + "}";
+    }
+
+    static auto get_bins_json(Solution &solution) -> std::string {
+        auto json = std::string{"["};
+        auto bins = solution.get_bin_items();
+
+        for (auto i : range(bins.size())) {
+            json += i ? ", [" : "[";
+
+            for (auto j : range(bins[i].size())) {
+                json += (j ? ", " : "") + std::to_string(bins[i][j]);
+            }
+
+            json += "]";
+        }
+
+        return json + "]";
+    }
+
+    auto finish_job(Job &job, const std::string &response) -> void {
+        {
+            auto lock = std::lock_guard<std::mutex>{this->mutex};
+            this->jobs.erase(job.id);
+        }
+
+        job.connection->send_line(response);
+    }
+
+    auto run_job(const JobPtr &job) -> void {
+        this->queued_job_count--;
+        auto queue_ms = get_elapsed_ms(job->received_at);
+        auto remaining_ms = job->time_limit_ms > 0 ? job->time_limit_ms - (int)queue_ms : 0;
+
+        // Requests cancelled or out of time while queued are answered without a solution.
+        if (job->cancelled.load() || (job->time_limit_ms > 0 && remaining_ms <= 0)) {
+            auto cancelled = job->cancelled.load();
+            (cancelled ? this->cancelled_job_count : this->expired_job_count)++;
+
+            this->finish_job(
+                *job,
+                "{\"id\": " + quote_json(job->id) + ", \"status\": \"" + (cancelled ? "cancelled" : "expired") +
+                    "\", \"queue_ms\": " + std::to_string(queue_ms) + "}");
+            return;
+        }
+
+        this->running_job_count++;
+
+        auto response = std::string{};
+
+        try {
+            auto result = solve(job->instance, job->algorithm, job->params, SolveBudget{remaining_ms, &job->cancelled});
+            auto &statistics = result.statistics;
+            auto &solution = result.get_best_solution();
+            auto cancelled = job->cancelled.load();
+
+            (cancelled ? this->cancelled_job_count : this->completed_job_count)++;
+
+            response = "{\"id\": " + quote_json(job->id) +
+                       ", \"status\": \"" + (cancelled ? "cancelled" : "ok") + "\"" +
+                       ", \"filled_bins\": " + std::to_string(solution.get_filled_bin_count()) +
+                       ", \"lower_bound\": " + std::to_string(statistics.get_lower_bound()) +
+                       ", \"gap\": " + std::to_string(solution.get_filled_bin_count() - statistics.get_lower_bound()) +
+                       ", \"seed\": " + std::to_string(result.seed) +
+                       ", \"queue_ms\": " + std::to_string(queue_ms) +
+                       ", \"elapsed_ms\": " + std::to_string(statistics.get_elapsed_ms()) +
+                       ", \"time_to_best_ms\": " + std::to_string(statistics.get_time_to_best_ms()) +
+                       ", \"queue_depth\": " + std::to_string(this->queued_job_count.load()) +
+                       ", \"bins\": " + get_bins_json(solution) + "}";
+        } catch (const std::exception &error) {
+            this->failed_job_count++;
+            response = get_error_json(job->id, error.what());
+        }
+
+        this->running_job_count--;
+        this->finish_job(*job, response);
+    }
+
+    static auto check_arg_limit(const std::string &algorithm, const std::vector<int> &args, int index, int limit)
+        -> void {
+        if (args[index] > limit) {
+            throw std::invalid_argument{
+                get_algorithm_spec(algorithm).expected_args[index].name + " above the limit of the server: " +
+                std::to_string(args[index]) + " (at most " + std::to_string(limit) + ")"};
+        }
+    }
+
+    // Requests already run in parallel, so a thread count not greater than 0 means 1
+    // instead of one per hardware thread; args above the limits are rejected.
+    auto limit_args(const std::string &algorithm, std::vector<int> &args) -> void {
+        auto thread_count_indexes = THREAD_COUNT_ARG_INDEXES.find(algorithm);
+        if (thread_count_indexes != THREAD_COUNT_ARG_INDEXES.end()) {
+            for (auto i : thread_count_indexes->second) {
+                args[i] = std::max(1, args[i]);
+                check_arg_limit(algorithm, args, i, this->limits.thread_count);
+            }
+        }
+
+        auto population_size_index = POPULATION_SIZE_ARG_INDEXES.find(algorithm);
+        if (population_size_index != POPULATION_SIZE_ARG_INDEXES.end()) {
+            check_arg_limit(algorithm, args, population_size_index->second, this->limits.population_size);
+        }
+
+        auto tabu_size_index = TABU_SIZE_ARG_INDEXES.find(algorithm);
+        if (tabu_size_index != TABU_SIZE_ARG_INDEXES.end()) {
+            check_arg_limit(algorithm, args, tabu_size_index->second, this->limits.tabu_size);
+        }
+    }
+
+    auto parse_job(const JsonValue &request, const ConnectionPtr &connection) -> JobPtr {
+        auto job = std::make_shared<Job>();
+        job->received_at = std::chrono::steady_clock::now();
+        job->connection = connection;
+        job->time_limit_ms = 0;
+        job->cancelled = false;
+
+        if (auto algorithm = request.find("algorithm")) {
+            job->algorithm = algorithm->get_string();
+        }
+        // Fails early on an unknown algorithm.
+        get_algorithm_spec(job->algorithm);
+
+        auto items = request.find("items");
+        if (!items || items->type != JsonType::ARRAY || items->array.empty()) {
+            throw std::invalid_argument{"Expected a non-empty items array"};
+        }
+
+        auto weights = std::vector<int>{};
+        weights.reserve(items->array.size());
+        for (auto &item : items->array) {
+            weights.push_back(item.get_int());
+        }
+
+        auto capacity = request.find("capacity");
+        auto bin_weight_limit = capacity ? capacity->get_int() : 0;
+        job->instance = std::make_shared<const Instance>(
+            bin_weight_limit > 0 ? bin_weight_limit : DEFAULT_BIN_WEIGHT_LIMIT,
+            std::move(weights));
+
+        auto args = std::vector<int>{};
+        if (auto request_args = request.find("args")) {
+            if (request_args->type != JsonType::ARRAY) {
+                throw std::invalid_argument{"Expected an args array"};
+            }
+
+            for (auto &arg : request_args->array) {
+                args.push_back(arg.get_int());
+            }
+        }
+
+        job->params.args = resolve_args(job->algorithm, args);
+        this->limit_args(job->algorithm, job->params.args);
+
+        if (auto options = request.find("options")) {
+            if (options->type != JsonType::OBJECT) {
+                throw std::invalid_argument{"Expected an options object"};
+            }
+
+            for (auto &[name, value] : options->object) {
+                job->params.options[name] = value.to_option_string();
+            }
+        }
+
+        if (auto time_limit_ms = request.find("time_limit_ms")) {
+            job->time_limit_ms = time_limit_ms->get_int();
+        }
+
+        return job;
+    }
+
+public:
+    SolverServer(int worker_count, RequestLimits limits)
+        : next_job_number(0),
+          queued_job_count(0),
+          running_job_count(0),
+          completed_job_count(0),
+          cancelled_job_count(0),
+          expired_job_count(0),
+          failed_job_count(0),
+          limits(limits),
+          workers(worker_count) {
+        // Builds the algorithm specs before the first request.
+        get_algorithm_names();
+    }
+
+    auto handle_line(const std::string &line, const ConnectionPtr &connection) -> void {
+        if (line.find_first_not_of(" \t\r") == std::string::npos) {
+            return;
+        }
+
+        auto id = std::string{};
+
+        try {
+            auto request = parse_json(line);
+
+            if (request.type != JsonType::OBJECT) {
+                throw std::invalid_argument{"Expected an object"};
+            }
+
+            if (auto request_id = request.find("id")) {
+                id = request_id->to_option_string();
+            }
+
+            if (request.find("metrics")) {
+                connection->send_line("{\"metrics\": " + this->get_metrics_json() + "}");
+                return;
+            }
+
+            if (auto cancel = request.find("cancel")) {
+                id = cancel->to_option_string();
+
+                auto lock = std::lock_guard<std::mutex>{this->mutex};
+                auto job = this->jobs.find(id);
+
+                if (job == this->jobs.end()) {
+                    throw std::invalid_argument{"No queued or running request with this id"};
+                }
+
+                // The job answers with its own cancelled response.
+                job->second->cancelled = true;
+                return;
+            }
+
+            auto job = this->parse_job(request, connection);
+
+            {
+                auto lock = std::lock_guard<std::mutex>{this->mutex};
+
+                if (id.empty()) {
+                    id = "#" + std::to_string(++this->next_job_number);
+                }
+
+                if (this->jobs.count(id)) {
+                    throw std::invalid_argument{"A request with this id is already queued or running"};
+                }
+
+                job->id = id;
+                this->jobs[id] = job;
+                this->queued_job_count++;
+            }
+
+            this->workers.submit([this, job]() { this->run_job(job); });
+        } catch (const std::exception &error) {
+            connection->send_line(get_error_json(id, error.what()));
+        }
+    }
+
+    // Jobs of a client that has gone away are of no use any more.
+    auto cancel_jobs_of(const ConnectionPtr &connection) -> void {
+        auto lock = std::lock_guard<std::mutex>{this->mutex};
+
+        for (auto &[_, job] : this->jobs) {
+            if (job->connection == connection) {
+                job->cancelled = true;
+            }
+        }
+    }
+};
+
+static auto serve_socket(SolverServer &server, const std::string &path) -> void {
+    auto listen_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    auto address = sockaddr_un{};
+    address.sun_family = AF_UNIX;
+
+    if (listen_fd < 0 || path.size() >= sizeof(address.sun_path)) {
+        throw std::runtime_error{"Cannot create socket: " + path};
+    }
+
+    path.copy(address.sun_path, path.size());
+    unlink(path.c_str());
+
+    if (bind(listen_fd, (sockaddr *)&address, sizeof(address)) < 0 || listen(listen_fd, 64) < 0) {
+        throw std::runtime_error{"Cannot listen on socket: " + path};
+    }
+
+    std::cerr << "Listening on " << path << std::endl;
+
+    while (true) {
+        auto fd = accept(listen_fd, nullptr, nullptr);
+
+        if (fd < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+
+            throw std::runtime_error{"Cannot accept on socket: " + path};
+        }
+
+        std::thread{[&server, fd]() {
+            auto connection = std::make_shared<Connection>(fd, true);
+            read_lines(fd, [&](const std::string &line) { server.handle_line(line, connection); });
+            server.cancel_jobs_of(connection);
+        }}.detach();
+    }
+}
+
+static auto run_server(int argc, char *argv[]) -> int {
+    auto options = collect_options(
+        {
+            {
+                "socket",
+                "Unix domain socket to listen on; empty -> one client on stdin and stdout",
+                "",
+            },
+            {
+                "workers",
+                "Requests solved at once; not greater than 0 means one per hardware thread",
+                "0",
+            },
+            {
+                "max-request-threads",
+                "Most threads, chains or islands of one request; not greater than 0 means one per hardware thread",
+                "0",
+            },
+            {
+                "max-population-size",
+                "Largest genetic algorithm population of one request",
+                "10000",
+            },
+            {
+                "max-tabu-size",
+                "Largest tabu size of one request",
+                "1000000",
+            },
+        },
+        argc, argv);
+
+    if (argc >= 2 && std::string{argv[1]} == "help") {
+        return 0;
+    }
+
+    // Writes to a closed socket fail with EPIPE instead.
+    std::signal(SIGPIPE, SIG_IGN);
+
+    auto limits = RequestLimits{
+        resolve_thread_count(get_int_option(options, "max-request-threads")),
+        get_int_option(options, "max-population-size"),
+        get_int_option(options, "max-tabu-size"),
+    };
+    auto server = SolverServer{get_int_option(options, "workers"), limits};
+
+    if (!options["socket"].empty()) {
+        serve_socket(server, options["socket"]);
+        return 0;
+    }
+
+    // Queued requests still run after end of input; the server destructor waits for them.
+    auto connection = std::make_shared<Connection>(STDOUT_FILENO, false);
+    read_lines(STDIN_FILENO, [&](const std::string &line) { server.handle_line(line, connection); });
+
+    return 0;
+}
+
+int main(int argc, char *argv[]) {
+    try {
+        return run_server(argc, argv);
+    } catch (const std::exception &error) {
+        std::cerr << "Error: " << error.what() << std::endl;
+        return 1;
+    }
+}
@@ -1,9 +1,14 @@
 #include "utils.h"
 #include "GarbageBag.h"
-#include <fstream>
+#include "Instance.h"
+#include "Random.h"
+#include <cstdint>
 #include <iostream>
+#include <limits>
 #include <map>
 #include <set>
+#include <stdexcept>
+#include <string>
 #include <vector>
 
 // using std::ranges::iota_view requires GCC v10
@@ -17,6 +22,78 @@ auto range(int len) -> std::vector<int> {
     return v;
 }
 
+auto get_instance_options() -> std::vector<ExpectedOption> {
+    return {
+        {
+            "data",
+            "Instance file: whitespace separated weights or the binary format",
+            "./data.txt",
+        },
+        {
+            "capacity",
+            "Bin weight limit; not greater than 0 means the one stored in a binary instance, or " +
+                std::to_string(DEFAULT_BIN_WEIGHT_LIMIT),
+            "0",
+        },
+    };
+}
+
+auto get_solver_options() -> std::vector<ExpectedOption> {
+    auto expected_options = get_instance_options();
+
+    expected_options.push_back({
+        "statistics",
+        "1 -> print evaluation count, elapsed time and time to best after the run",
+        "0",
+    });
+    expected_options.push_back({
+        "time-limit-ms",
+        "Wall-clock budget; the best solution so far is returned when it runs out. 0 -> no limit",
+        "0",
+    });
+    expected_options.push_back({
+        "stream",
+        "1 -> print every new best solution as soon as it is found",
+        "0",
+    });
+    expected_options.push_back({
+        "start",
+        "Initial solution: instance (bags in file order), ffd (first fit decreasing) or bfd (best fit decreasing)",
+        "instance",
+    });
+    expected_options.push_back({
+        "seed",
+        "Seed of every random choice; 0 -> random seed, printed so the run can be reproduced",
+        "0",
+    });
+    expected_options.push_back({
+        "profile",
+        "File the hot-path counters are written to after the run: JSON when it ends with .json,"
+        " otherwise a CSV row; needs a `make PROFILE=1` build",
+        "",
+    });
+
+    return expected_options;
+}
+
+auto get_trajectory_solver_options() -> std::vector<ExpectedOption> {
+    auto expected_options = get_solver_options();
+
+    expected_options.push_back({
+        "neighborhood",
+        "adjacent (swap with the next bag), swap (any two bags), insert (move a bag elsewhere)"
+        " or block (move a whole bin elsewhere)",
+        "adjacent",
+    });
+    expected_options.push_back({
+        "candidate-bins",
+        "Least filled bins the swap, insert and block moves start from; not greater than 0 means every bin",
+        "16",
+    });
+
+    return expected_options;
+}
+
 auto print_help(const std::vector<ExpectedArg> &expected_args) -> void {
     std::cout << "Args:" << std::endl;
 
@@ -28,23 +105,45 @@ auto print_help(const std::vector<ExpectedArg> &expected_args) -> void {
         }
 
         std::cout << "   Default: " << expected_args[i].default_value << std::endl;
+
+        if (expected_args[i].min_value != std::numeric_limits<int>::min()) {
+            std::cout << "   Minimum: " << expected_args[i].min_value << std::endl;
+        }
+    }
+}
+
+auto print_options_help(const std::vector<ExpectedOption> &expected_options) -> void {
+    std::cout << "Options:" << std::endl;
+
+    for (auto &expected_option : expected_options) {
+        std::cout << "  --" << expected_option.name << std::endl;
+
+        if (expected_option.description.size()) {
+            std::cout << "   " << expected_option.description << std::endl;
+        }
+
+        std::cout << "   Default: " << expected_option.default_value << std::endl;
     }
+
+    std::cout << std::endl;
 }
 
 auto print_configuration(
     const std::vector<ExpectedArg> &expected_args,
-    const std::vector<int> input_values)
+    const std::vector<int> input_values,
+    std::ostream &out)
     -> void {
-    std::cout << "Configuration:" << std::endl;
+    out << "Configuration:" << std::endl;
     for (auto i : range(expected_args.size())) {
-        std::cout << "  " << expected_args[i].name << ": " << input_values[i] << std::endl;
+        out << "  " << expected_args[i].name << ": " << input_values[i] << std::endl;
     }
 }
 
 auto collect_args(
     const std::vector<ExpectedArg> &expected_args,
     int argc,
-    char *argv[])
+    char *argv[],
+    std::ostream &out)
     -> std::vector<int> {
     auto expected_args_size = expected_args.size();
 
@@ -75,22 +174,76 @@ auto collect_args(
         input_values.push_back(expected_args[i].default_value);
     }
 
-    print_configuration(expected_args, input_values);
+    print_configuration(expected_args, input_values, out);
 
-    std::cout << std::endl;
+    out << std::endl;
 
     return input_values;
 }
 
-auto load_garbage_bags() -> std::vector<GarbageBag> {
-    auto bags = std::vector<GarbageBag>{};
+auto collect_options(
+    const std::vector<ExpectedOption> &expected_options,
+    int &argc,
+    char *argv[])
+    -> Options {
+    auto options = Options{};
+
+    for (auto &expected_option : expected_options) {
+        options[expected_option.name] = expected_option.default_value;
+    }
+
+    if (argc >= 2 && std::string{argv[1]} == "help") {
+        print_options_help(expected_options);
+        return options;
+    }
+
+    auto positional_argc = 1;
+
+    for (auto i = 1; i < argc; i++) {
+        auto arg = std::string{argv[i]};
+
+        if (arg.rfind("--", 0) != 0) {
+            argv[positional_argc++] = argv[i];
+            continue;
+        }
+
+        auto name = arg.substr(2);
+        auto value = std::string{};
+        auto separator = name.find('=');
+
+        if (separator != std::string::npos) {
+            value = name.substr(separator + 1);
+            name = name.substr(0, separator);
+        } else if (i + 1 < argc) {
+            value = argv[++i];
+        } else {
+            throw std::invalid_argument{"Missing value of option: --" + name};
+        }
 
-    auto data = std::fstream{"./data.txt", std::ios_base::in};
+        if (!options.count(name)) {
+            throw std::invalid_argument{"Unknown option: --" + name};
+        }
 
-    int weight;
-    while (data >> weight) {
-        bags.push_back(GarbageBag{weight});
+        options[name] = value;
     }
 
-    return bags;
+    argc = positional_argc;
+
+    return options;
+}
+
+auto get_int_option(const Options &options, const std::string &name) -> int {
+    return std::stoi(options.at(name));
+}
+
+auto get_seed_option(const Options &options, std::ostream &out) -> std::uint64_t {
+    auto seed = resolve_seed(std::stoull(options.at("seed")));
+
+    out << "Seed: " << seed << std::endl;
+
+    return seed;
+}
+
+auto load_instance(const Options &options) -> InstancePtr {
+    return load_instance(options.at("data"), get_int_option(options, "capacity"));
 }
@@ -1,7 +1,12 @@
 #include "GarbageBag.h"
+#include "Instance.h"
+#include "Random.h"
+#include <cstdint>
 #include <iostream>
+#include <limits>
 #include <map>
 #include <set>
+#include <string>
 #include <vector>
 
 #ifndef UTILS_H
@@ -15,21 +20,60 @@ struct ExpectedArg {
     std::string description;
     std::set<int> allowed_values;
     int default_value;
+    // Smaller values are rejected by solve().
+    int min_value = std::numeric_limits<int>::min();
 };
 
+struct ExpectedOption {
+    std::string name;
+    std::string description;
+    std::string default_value;
+};
+
+using Options = std::map<std::string, std::string>;
+
+// Options selecting the instance; accepted by every binary.
+auto get_instance_options() -> std::vector<ExpectedOption>;
+
+// Instance options plus the ones accepted by every solver binary.
+auto get_solver_options() -> std::vector<ExpectedOption>;
+
+// Solver options plus the neighborhood selection of trajectory solvers.
+auto get_trajectory_solver_options() -> std::vector<ExpectedOption>;
+
 auto print_help(const std::vector<ExpectedArg> &expected_args) -> void;
 
+auto print_options_help(const std::vector<ExpectedOption> &expected_options) -> void;
+
 auto print_configuration(
     const std::vector<ExpectedArg> &expected_args,
-    const std::vector<int> input_values)
+    const std::vector<int> input_values,
+    std::ostream &out = std::cout)
     -> void;
 
+// The configuration is printed to `out`; help to stdout.
 auto collect_args(
     const std::vector<ExpectedArg> &expected_args,
     int argc,
-    char *argv[])
+    char *argv[],
+    std::ostream &out = std::cout)
     -> std::vector<int>;
 
+// Collects `--name value` and `--name=value` options and removes them from
+// argv, so that collect_args only sees positional args.
+auto collect_options(
+    const std::vector<ExpectedOption> &expected_options,
+    int &argc,
+    char *argv[])
+    -> Options;
+
+auto get_int_option(const Options &options, const std::string &name) -> int;
+
+// Seed option with 0 resolved to a random seed, which is printed to `out`.
+auto get_seed_option(const Options &options, std::ostream &out = std::cout) -> std::uint64_t;
+
+auto load_instance(const Options &options) -> InstancePtr;
+
 template <typename T>
 inline auto map_keys_to_set(const std::map<int, T> &map) -> std::set<int> {
     auto set = std::set<int>{};
@@ -41,6 +85,4 @@ inline auto map_keys_to_set(const std::map<int, T> &map) -> std::set<int> {
     return set;
 };
 
-auto load_garbage_bags() -> std::vector<GarbageBag>;
-
 #endif // UTILS_H